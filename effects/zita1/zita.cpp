@@ -19,6 +19,10 @@
 #include <math.h>
 #include "zita.h"
 
+#ifdef ZITA_USE_SSE
+#include <emmintrin.h>
+#endif
+
 namespace Ms {
 
 enum {
@@ -56,7 +60,10 @@ Pareq::Pareq()
     _g0 (1),
     _g1 (1),
     _f0 (1e3f),
-    _f1 (1e3f)
+    _f1 (1e3f),
+    _c1 (0), _dc1 (0),
+    _c2 (0), _dc2 (0),
+    _gg (0), _dgg (0)
       {
       setfsamp(0.0f);
       }
@@ -212,6 +219,57 @@ void Pareq::process1(int nsamp, float* data)
             }
       }
 
+#ifdef ZITA_USE_SSE
+//---------------------------------------------------------
+//   process1Sse
+//    same as process1(), both channels of a frame are
+//    filtered in one register
+//---------------------------------------------------------
+
+void Pareq::process1Sse(int nsamp, float* data)
+      {
+      __m128 z1 = _mm_setr_ps(_z1[0], _z1[1], 0.0f, 0.0f);
+      __m128 z2 = _mm_setr_ps(_z2[0], _z2[1], 0.0f, 0.0f);
+      __m128 c1 = _mm_set1_ps(_c1);
+      __m128 c2 = _mm_set1_ps(_c2);
+      __m128 gg = _mm_set1_ps(_gg);
+      const __m128 tiny = _mm_set1_ps(1e-20f);
+      const bool smooth = _state == SMOOTH;
+      const __m128 dc1  = _mm_set1_ps(smooth ? _dc1 : 0.0f);
+      const __m128 dc2  = _mm_set1_ps(smooth ? _dc2 : 0.0f);
+      const __m128 dgg  = _mm_set1_ps(smooth ? _dgg : 0.0f);
+
+      for (int j = 0; j < nsamp; j++) {
+            if (smooth) {
+                  c1 = _mm_add_ps(c1, dc1);
+                  c2 = _mm_add_ps(c2, dc2);
+                  gg = _mm_add_ps(gg, dgg);
+                  }
+            float* p = data + j * 2;
+            __m128 x = _mm_loadl_pi(_mm_setzero_ps(), reinterpret_cast<const __m64*>(p));
+            __m128 y = _mm_sub_ps(x, _mm_mul_ps(c2, z2));
+            __m128 t = _mm_sub_ps(_mm_add_ps(z2, _mm_mul_ps(c2, y)), x);
+            _mm_storel_pi(reinterpret_cast<__m64*>(p), _mm_sub_ps(x, _mm_mul_ps(gg, t)));
+            y  = _mm_sub_ps(y, _mm_mul_ps(c1, z1));
+            z2 = _mm_add_ps(z1, _mm_mul_ps(c1, y));
+            z1 = _mm_add_ps(y, tiny);
+            }
+
+      alignas(16) float v[4];
+      _mm_store_ps(v, z1);
+      _z1[0] = v[0];
+      _z1[1] = v[1];
+      _mm_store_ps(v, z2);
+      _z2[0] = v[0];
+      _z2[1] = v[1];
+      if (smooth) {
+            _c1 = _mm_cvtss_f32(c1);
+            _c2 = _mm_cvtss_f32(c2);
+            _gg = _mm_cvtss_f32(gg);
+            }
+      }
+#endif
+
 Diff1::~Diff1()
       {
       fini();
@@ -418,15 +476,220 @@ void ZitaReverb::prepare (int nfram)
       }
 
 //---------------------------------------------------------
-//   process
+//   setVectorized
 //---------------------------------------------------------
 
-void ZitaReverb::process (int nfram, float* inp, float* out)
+void ZitaReverb::setVectorized(bool val)
+      {
+      _vectorized = val;
+      _pareq1.setVectorized(val);
+      _pareq2.setVectorized(val);
+      }
+
+//---------------------------------------------------------
+//   processLines
+//    run the input delays and the feedback delay network
+//    for n frames, writes the reverb signal to out
+//---------------------------------------------------------
+
+void ZitaReverb::processLines(int n, const float* inp, float* out)
       {
       float t, g, x0, x1, x2, x3, x4, x5, x6, x7;
       g = sqrtf (0.125f);
 
+      const float* p0 = inp;
+      const float* p1 = inp + 1;
+      float* q0 = out;
+      float* q1 = out + 1;
+
+      for (int i = 0; i < n * 2; i += 2) {
+            _vdelay0.write (p0 [i]);
+            _vdelay1.write (p1 [i]);
+
+            t = 0.3f * _vdelay0.read ();
+            x0 = _diff1 [0].process (_delay [0].read () + t);
+            x1 = _diff1 [1].process (_delay [1].read () + t);
+            x2 = _diff1 [2].process (_delay [2].read () - t);
+            x3 = _diff1 [3].process (_delay [3].read () - t);
+            t = 0.3f * _vdelay1.read ();
+            x4 = _diff1 [4].process (_delay [4].read () + t);
+            x5 = _diff1 [5].process (_delay [5].read () + t);
+            x6 = _diff1 [6].process (_delay [6].read () - t);
+            x7 = _diff1 [7].process (_delay [7].read () - t);
+
+            t = x0 - x1; x0 += x1;  x1 = t;
+            t = x2 - x3; x2 += x3;  x3 = t;
+            t = x4 - x5; x4 += x5;  x5 = t;
+            t = x6 - x7; x6 += x7;  x7 = t;
+            t = x0 - x2; x0 += x2;  x2 = t;
+            t = x1 - x3; x1 += x3;  x3 = t;
+            t = x4 - x6; x4 += x6;  x6 = t;
+            t = x5 - x7; x5 += x7;  x7 = t;
+            t = x0 - x4; x0 += x4;  x4 = t;
+            t = x1 - x5; x1 += x5;  x5 = t;
+            t = x2 - x6; x2 += x6;  x6 = t;
+            t = x3 - x7; x3 += x7;  x7 = t;
+
+            _g1 += _d1;
+
+            q0 [i] = _g1 * (x1 + x2);
+            q1 [i] = _g1 * (x1 - x2);
+
+            _delay [0].write (_filt1 [0].process (g * x0));
+            _delay [1].write (_filt1 [1].process (g * x1));
+            _delay [2].write (_filt1 [2].process (g * x2));
+            _delay [3].write (_filt1 [3].process (g * x3));
+            _delay [4].write (_filt1 [4].process (g * x4));
+            _delay [5].write (_filt1 [5].process (g * x5));
+            _delay [6].write (_filt1 [6].process (g * x6));
+            _delay [7].write (_filt1 [7].process (g * x7));
+            }
+      }
+
+#ifdef ZITA_USE_SSE
+//---------------------------------------------------------
+//   processLinesSse
+//    same as processLines(), the eight lines are processed
+//    in two registers (lines 0-3 and 4-7). Frames are
+//    handled in runs in which no delay line index wraps
+//    around, so the inner loop only does plain loads and
+//    stores. The arithmetic is done in the same order as
+//    in the scalar code.
+//---------------------------------------------------------
 
+void ZitaReverb::processLinesSse(int n, const float* inp, float* out)
+      {
+      const __m128 g    = _mm_set1_ps(sqrtf(0.125f));
+      const __m128 tiny = _mm_set1_ps(1e-10f);
+      const __m128 neg13 = _mm_castsi128_ps(_mm_setr_epi32(0, int(0x80000000), 0, int(0x80000000)));
+      const __m128 neg23 = _mm_castsi128_ps(_mm_setr_epi32(0, 0, int(0x80000000), int(0x80000000)));
+
+      const __m128 cA   = _mm_setr_ps(_diff1[0]._c,   _diff1[1]._c,   _diff1[2]._c,   _diff1[3]._c);
+      const __m128 cB   = _mm_setr_ps(_diff1[4]._c,   _diff1[5]._c,   _diff1[6]._c,   _diff1[7]._c);
+      const __m128 gmfA = _mm_setr_ps(_filt1[0]._gmf, _filt1[1]._gmf, _filt1[2]._gmf, _filt1[3]._gmf);
+      const __m128 gmfB = _mm_setr_ps(_filt1[4]._gmf, _filt1[5]._gmf, _filt1[6]._gmf, _filt1[7]._gmf);
+      const __m128 gloA = _mm_setr_ps(_filt1[0]._glo, _filt1[1]._glo, _filt1[2]._glo, _filt1[3]._glo);
+      const __m128 gloB = _mm_setr_ps(_filt1[4]._glo, _filt1[5]._glo, _filt1[6]._glo, _filt1[7]._glo);
+      const __m128 wloA = _mm_setr_ps(_filt1[0]._wlo, _filt1[1]._wlo, _filt1[2]._wlo, _filt1[3]._wlo);
+      const __m128 wloB = _mm_setr_ps(_filt1[4]._wlo, _filt1[5]._wlo, _filt1[6]._wlo, _filt1[7]._wlo);
+      const __m128 whiA = _mm_setr_ps(_filt1[0]._whi, _filt1[1]._whi, _filt1[2]._whi, _filt1[3]._whi);
+      const __m128 whiB = _mm_setr_ps(_filt1[4]._whi, _filt1[5]._whi, _filt1[6]._whi, _filt1[7]._whi);
+      __m128 sloA = _mm_setr_ps(_filt1[0]._slo, _filt1[1]._slo, _filt1[2]._slo, _filt1[3]._slo);
+      __m128 sloB = _mm_setr_ps(_filt1[4]._slo, _filt1[5]._slo, _filt1[6]._slo, _filt1[7]._slo);
+      __m128 shiA = _mm_setr_ps(_filt1[0]._shi, _filt1[1]._shi, _filt1[2]._shi, _filt1[3]._shi);
+      __m128 shiB = _mm_setr_ps(_filt1[4]._shi, _filt1[5]._shi, _filt1[6]._shi, _filt1[7]._shi);
+
+      alignas(16) float v[8];
+
+      while (n > 0) {
+            // length of the next run without index wrap around
+            int run = n;
+            run = qMin(run, _vdelay0._size - _vdelay0._iw);
+            run = qMin(run, _vdelay0._size - _vdelay0._ir);
+            run = qMin(run, _vdelay1._size - _vdelay1._iw);
+            run = qMin(run, _vdelay1._size - _vdelay1._ir);
+            for (int j = 0; j < 8; ++j) {
+                  run = qMin(run, _diff1[j]._size - _diff1[j]._i);
+                  run = qMin(run, _delay[j]._size - _delay[j]._i);
+                  }
+
+            float* w0 = _vdelay0._line + _vdelay0._iw;
+            float* w1 = _vdelay1._line + _vdelay1._iw;
+            const float* r0 = _vdelay0._line + _vdelay0._ir;
+            const float* r1 = _vdelay1._line + _vdelay1._ir;
+            float* d[8];
+            float* f[8];
+            for (int j = 0; j < 8; ++j) {
+                  d[j] = _delay[j]._line + _delay[j]._i;
+                  f[j] = _diff1[j]._line + _diff1[j]._i;
+                  }
+
+            for (int i = 0; i < run; ++i) {
+                  w0[i] = inp[2 * i];
+                  w1[i] = inp[2 * i + 1];
+
+                  // delay lines plus input, lines 2, 3, 6, 7 subtract it
+                  __m128 tA = _mm_xor_ps(_mm_set1_ps(0.3f * r0[i]), neg23);
+                  __m128 tB = _mm_xor_ps(_mm_set1_ps(0.3f * r1[i]), neg23);
+                  __m128 xA = _mm_add_ps(_mm_setr_ps(d[0][i], d[1][i], d[2][i], d[3][i]), tA);
+                  __m128 xB = _mm_add_ps(_mm_setr_ps(d[4][i], d[5][i], d[6][i], d[7][i]), tB);
+
+                  // Diff1
+                  __m128 zA = _mm_setr_ps(f[0][i], f[1][i], f[2][i], f[3][i]);
+                  __m128 zB = _mm_setr_ps(f[4][i], f[5][i], f[6][i], f[7][i]);
+                  xA = _mm_sub_ps(xA, _mm_mul_ps(cA, zA));
+                  xB = _mm_sub_ps(xB, _mm_mul_ps(cB, zB));
+                  _mm_store_ps(v, xA);
+                  _mm_store_ps(v + 4, xB);
+                  for (int j = 0; j < 8; ++j)
+                        f[j][i] = v[j];
+                  xA = _mm_add_ps(zA, _mm_mul_ps(cA, xA));
+                  xB = _mm_add_ps(zB, _mm_mul_ps(cB, xB));
+
+                  // Hadamard mixing: pairs (0,1), then (0,2), then (0,4)
+                  xA = _mm_add_ps(_mm_shuffle_ps(xA, xA, _MM_SHUFFLE(2, 2, 0, 0)),
+                                  _mm_xor_ps(_mm_shuffle_ps(xA, xA, _MM_SHUFFLE(3, 3, 1, 1)), neg13));
+                  xB = _mm_add_ps(_mm_shuffle_ps(xB, xB, _MM_SHUFFLE(2, 2, 0, 0)),
+                                  _mm_xor_ps(_mm_shuffle_ps(xB, xB, _MM_SHUFFLE(3, 3, 1, 1)), neg13));
+                  xA = _mm_add_ps(_mm_shuffle_ps(xA, xA, _MM_SHUFFLE(1, 0, 1, 0)),
+                                  _mm_xor_ps(_mm_shuffle_ps(xA, xA, _MM_SHUFFLE(3, 2, 3, 2)), neg23));
+                  xB = _mm_add_ps(_mm_shuffle_ps(xB, xB, _MM_SHUFFLE(1, 0, 1, 0)),
+                                  _mm_xor_ps(_mm_shuffle_ps(xB, xB, _MM_SHUFFLE(3, 2, 3, 2)), neg23));
+                  __m128 t = _mm_sub_ps(xA, xB);
+                  xA = _mm_add_ps(xA, xB);
+                  xB = t;
+
+                  _g1 += _d1;
+                  _mm_store_ps(v, xA);
+                  out[2 * i]     = _g1 * (v[1] + v[2]);
+                  out[2 * i + 1] = _g1 * (v[1] - v[2]);
+
+                  // Filt1
+                  xA = _mm_mul_ps(g, xA);
+                  xB = _mm_mul_ps(g, xB);
+                  sloA = _mm_add_ps(sloA, _mm_add_ps(_mm_mul_ps(wloA, _mm_sub_ps(xA, sloA)), tiny));
+                  sloB = _mm_add_ps(sloB, _mm_add_ps(_mm_mul_ps(wloB, _mm_sub_ps(xB, sloB)), tiny));
+                  xA = _mm_add_ps(xA, _mm_mul_ps(gloA, sloA));
+                  xB = _mm_add_ps(xB, _mm_mul_ps(gloB, sloB));
+                  shiA = _mm_add_ps(shiA, _mm_mul_ps(whiA, _mm_sub_ps(xA, shiA)));
+                  shiB = _mm_add_ps(shiB, _mm_mul_ps(whiB, _mm_sub_ps(xB, shiB)));
+                  _mm_store_ps(v, _mm_mul_ps(gmfA, shiA));
+                  _mm_store_ps(v + 4, _mm_mul_ps(gmfB, shiB));
+                  for (int j = 0; j < 8; ++j)
+                        d[j][i] = v[j];
+                  }
+
+            // advance all line indices
+            _vdelay0._iw = (_vdelay0._iw + run) % _vdelay0._size;
+            _vdelay0._ir = (_vdelay0._ir + run) % _vdelay0._size;
+            _vdelay1._iw = (_vdelay1._iw + run) % _vdelay1._size;
+            _vdelay1._ir = (_vdelay1._ir + run) % _vdelay1._size;
+            for (int j = 0; j < 8; ++j) {
+                  _diff1[j]._i = (_diff1[j]._i + run) % _diff1[j]._size;
+                  _delay[j]._i = (_delay[j]._i + run) % _delay[j]._size;
+                  }
+            inp += run * 2;
+            out += run * 2;
+            n   -= run;
+            }
+
+      _mm_store_ps(v, sloA);
+      _mm_store_ps(v + 4, sloB);
+      for (int j = 0; j < 8; ++j)
+            _filt1[j]._slo = v[j];
+      _mm_store_ps(v, shiA);
+      _mm_store_ps(v + 4, shiB);
+      for (int j = 0; j < 8; ++j)
+            _filt1[j]._shi = v[j];
+      }
+#endif
+
+//---------------------------------------------------------
+//   process
+//---------------------------------------------------------
+
+void ZitaReverb::process (int nfram, float* inp, float* out)
+      {
       while (nfram) {
             if (!_nsamp) {
                   prepare(_fragm);
@@ -435,53 +698,12 @@ void ZitaReverb::process (int nfram, float* inp, float* out)
 
             int k = _nsamp < nfram ? _nsamp : nfram;
 
-            float* p0 = inp;
-            float* p1 = inp + 1;
-            float* q0 = out;
-            float* q1 = out + 1;
-
-            for (int i = 0; i < k * 2; i += 2) {
-                  _vdelay0.write (p0 [i]);
-                  _vdelay1.write (p1 [i]);
-
-                  t = 0.3f * _vdelay0.read ();
-                  x0 = _diff1 [0].process (_delay [0].read () + t);
-                  x1 = _diff1 [1].process (_delay [1].read () + t);
-                  x2 = _diff1 [2].process (_delay [2].read () - t);
-                  x3 = _diff1 [3].process (_delay [3].read () - t);
-                  t = 0.3f * _vdelay1.read ();
-                  x4 = _diff1 [4].process (_delay [4].read () + t);
-                  x5 = _diff1 [5].process (_delay [5].read () + t);
-                  x6 = _diff1 [6].process (_delay [6].read () - t);
-                  x7 = _diff1 [7].process (_delay [7].read () - t);
-
-                  t = x0 - x1; x0 += x1;  x1 = t;
-                  t = x2 - x3; x2 += x3;  x3 = t;
-                  t = x4 - x5; x4 += x5;  x5 = t;
-                  t = x6 - x7; x6 += x7;  x7 = t;
-                  t = x0 - x2; x0 += x2;  x2 = t;
-                  t = x1 - x3; x1 += x3;  x3 = t;
-                  t = x4 - x6; x4 += x6;  x6 = t;
-                  t = x5 - x7; x5 += x7;  x7 = t;
-                  t = x0 - x4; x0 += x4;  x4 = t;
-                  t = x1 - x5; x1 += x5;  x5 = t;
-                  t = x2 - x6; x2 += x6;  x6 = t;
-                  t = x3 - x7; x3 += x7;  x7 = t;
-
-                  _g1 += _d1;
-
-                  q0 [i] = _g1 * (x1 + x2);
-                  q1 [i] = _g1 * (x1 - x2);
-
-                  _delay [0].write (_filt1 [0].process (g * x0));
-                  _delay [1].write (_filt1 [1].process (g * x1));
-                  _delay [2].write (_filt1 [2].process (g * x2));
-                  _delay [3].write (_filt1 [3].process (g * x3));
-                  _delay [4].write (_filt1 [4].process (g * x4));
-                  _delay [5].write (_filt1 [5].process (g * x5));
-                  _delay [6].write (_filt1 [6].process (g * x6));
-                  _delay [7].write (_filt1 [7].process (g * x7));
-                  }
+#ifdef ZITA_USE_SSE
+            if (_vectorized)
+                  processLinesSse(k, inp, out);
+            else
+#endif
+                  processLines(k, inp, out);
             _pareq1.process (k, out);
             _pareq2.process (k, out);
 
@@ -21,6 +21,10 @@
 
 #include "effects/effect.h"
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define ZITA_USE_SSE
+#endif
+
 namespace Ms {
 
 class EffectGui;
@@ -35,6 +39,9 @@ class Pareq
 
       void calcpar1 (int nsamp, float g, float f);
       void process1 (int nsamp, float*);
+#ifdef ZITA_USE_SSE
+      void process1Sse (int nsamp, float*);
+#endif
 
       volatile int16_t  _touch0;
       volatile int16_t  _touch1;
@@ -43,6 +50,7 @@ class Pareq
 #endif
       int               _state;
       float             _fsamp;
+      bool              _vectorized { true };
 
       float             _g;
       float             _g0, _g1;
@@ -74,9 +82,17 @@ class Pareq
       void reset();
       void prepare(int nsamp);
       void process(int nsamp, float* data) {
-            if (_state != BYPASS)
-                 process1(nsamp, data);
+            if (_state == BYPASS)
+                  return;
+#ifdef ZITA_USE_SSE
+            if (_vectorized) {
+                  process1Sse(nsamp, data);
+                  return;
+                  }
+#endif
+            process1(nsamp, data);
             }
+      void setVectorized(bool val) { _vectorized = val; }
       };
 
 //---------------------------------------------------------
@@ -236,7 +252,13 @@ class ZitaReverb : public Effect
       int _fragm;
       int _nsamp;
 
+      bool _vectorized { true };
+
       void prepare(int n);
+      void processLines(int n, const float* inp, float* out);
+#ifdef ZITA_USE_SSE
+      void processLinesSse(int n, const float* inp, float* out);
+#endif
 
    public:
       ZitaReverb() : Effect() {}
@@ -247,6 +269,10 @@ class ZitaReverb : public Effect
 
       virtual void process(int n, float* inp, float* out);
 
+      // use the SSE kernels if available, the scalar code is kept as reference
+      void setVectorized(bool val);
+      bool vectorized() const { return _vectorized; }
+
       void set_delay(float v) { _ipdel = v; _cntA1++; }
       float delay() const     { return _ipdel; }
 
@@ -348,6 +348,7 @@ class Fluid : public Synthesizer {
 
       virtual void allSoundsOff(int);
       virtual void allNotesOff(int);
+      virtual int voiceCount() const override { return activeVoices.size(); }
 
       int loadProgress()            { return _loadProgress; }
       void setLoadProgress(int val) { _loadProgress = val; }
@@ -1720,6 +1720,7 @@ void ChordList::read(XmlReader& e)
                   chordTokenList.append(t);
                   }
             else if (tag == "chord") {
+                  invalidateIndex();
                   int id = e.intAttribute("id");
                   // if no id attribute (id == 0), then assign it a private id
                   // user chords that match these ChordDescriptions will be treated as normal recognized chords
@@ -1885,6 +1886,87 @@ bool ChordList::loaded() const
       return !renderListRoot.empty();
       }
 
+//---------------------------------------------------------
+//   indexDescription
+//    A name resolves to the description with the lowest
+//    id, a parsed chord to the one with the highest id,
+//    the same as a linear search over the list does.
+//---------------------------------------------------------
+
+void ChordList::indexDescription(const ChordDescription& cd) const
+      {
+      if (cd.names.empty())
+            return;
+      for (const QString& name : cd.names) {
+            auto i = _nameIndex.find(name);
+            if (i == _nameIndex.end())
+                  _nameIndex.insert(name, cd.id);
+            else if (cd.id < i.value())
+                  i.value() = cd.id;
+            }
+      for (const ParsedChord& pc : cd.parsedChords) {
+            auto i = _parsedIndex.find(pc.handle());
+            if (i == _parsedIndex.end())
+                  _parsedIndex.insert(pc.handle(), cd.id);
+            else if (cd.id > i.value())
+                  i.value() = cd.id;
+            }
+      }
+
+//---------------------------------------------------------
+//   buildIndex
+//---------------------------------------------------------
+
+void ChordList::buildIndex() const
+      {
+      _nameIndex.clear();
+      _parsedIndex.clear();
+      for (const ChordDescription& cd : *this)
+            indexDescription(cd);
+      _indexedCount = size();
+      }
+
+//---------------------------------------------------------
+//   description
+//    look up name in chord list
+//    optionally look up by parsed chord as fallback
+//    return chord description if found, or null
+//---------------------------------------------------------
+
+const ChordDescription* ChordList::description(const QString& name, const ParsedChord* pc) const
+      {
+      if (_indexedCount != size())
+            buildIndex();
+      auto i = _nameIndex.constFind(name);
+      if (i == _nameIndex.constEnd()) {
+            // exact match failed, so fall back on parsed match
+            if (!pc)
+                  return 0;
+            i = _parsedIndex.constFind(pc->handle());
+            if (i == _parsedIndex.constEnd())
+                  return 0;
+            }
+      auto cd = constFind(i.value());
+      return cd == constEnd() ? 0 : &*cd;
+      }
+
+//---------------------------------------------------------
+//   addDescription
+//    add a description with a new id and keep
+//    the index up to date
+//---------------------------------------------------------
+
+const ChordDescription* ChordList::addDescription(const ChordDescription& cd)
+      {
+      const bool indexValid = (_indexedCount == size()) && !contains(cd.id);
+      auto i = insert(cd.id, cd);
+      if (indexValid) {
+            indexDescription(*i);
+            _indexedCount = size();
+            }
+      return &*i;
+      }
+
 //---------------------------------------------------------
 //   unload
 //---------------------------------------------------------
@@ -1892,6 +1974,7 @@ bool ChordList::loaded() const
 void ChordList::unload()
       {
       clear();
+      invalidateIndex();
       symbols.clear();
       fonts.clear();
       renderListRoot.clear();
@@ -234,6 +234,14 @@ class ChordList : public QMap<int, ChordDescription> {
       qreal _emag = 1.0, _eadjust = 0.0;
       qreal _mmag = 1.0, _madjust = 0.0;
 
+      // lookup tables for description(), built on demand
+      mutable QHash<QString, int> _nameIndex;         // name -> lowest id using it
+      mutable QHash<QString, int> _parsedIndex;       // parsed chord handle -> highest id using it
+      mutable int _indexedCount = -1;                 // size() when the index was built, -1 if invalid
+
+      void buildIndex() const;
+      void indexDescription(const ChordDescription&) const;
+
    public:
       QList<ChordFont> fonts;
       QList<RenderAction> renderListRoot;
@@ -255,6 +263,10 @@ class ChordList : public QMap<int, ChordDescription> {
       bool loaded() const;
       void unload();
       ChordSymbol symbol(const QString& s) const { return symbols.value(s); }
+
+      const ChordDescription* description(const QString& name, const ParsedChord* pc) const;
+      const ChordDescription* addDescription(const ChordDescription& cd);
+      void invalidateIndex()                    { _indexedCount = -1; }
       };
 
 
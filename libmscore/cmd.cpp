@@ -178,6 +178,27 @@ void CmdState::setUpdateMode(UpdateMode m)
             _setUpdateMode(m);
       }
 
+//---------------------------------------------------------
+//   merge
+//    add the changes recorded in s, used to collect the
+//    state of a DetachedCmd; the edited element is not
+//    taken over
+//---------------------------------------------------------
+
+void CmdState::merge(const CmdState& s)
+      {
+      if (s._startTick != Fraction(-1,1)) {
+            setTick(s._startTick);
+            setTick(s._endTick);
+            }
+      setStaff(s._startStaff);
+      setStaff(s._endStaff);
+      setUpdateMode(s._updateMode);
+      layoutFlags         |= s.layoutFlags;
+      _excerptsChanged    = _excerptsChanged || s._excerptsChanged;
+      _instrumentsChanged = _instrumentsChanged || s._instrumentsChanged;
+      }
+
 //---------------------------------------------------------
 //   startCmd
 ///   Start a GUI command by clearing the redraw area
@@ -2657,14 +2678,18 @@ void Score::cmdExplode()
                   lastStaff = qMin(nstaves(), srcStaff + n);
                   }
 
-            const QByteArray mimeData(selection().mimeData());
+            // serialize once, paste from the tokens into every staff
+            XmlTokens tokens;
+            XmlWriter xml(this);
+            xml.setTokens(&tokens);
+            selection().writeStaffList(xml);
             // copy to all destination staves
             Segment* firstCRSegment = startMeasure->tick2segment(startMeasure->tick());
             for (int i = 1; srcStaff + i < lastStaff; ++i) {
                   int track = (srcStaff + i) * VOICES;
                   ChordRest* cr = toChordRest(firstCRSegment->element(track));
                   if (cr) {
-                        XmlReader e(mimeData);
+                        XmlReader e(&tokens);
                         e.setPasteMode(true);
                         pasteStaff(e, cr->segment(), cr->staffIdx());
                         }
@@ -501,8 +501,8 @@ bool Score::rewriteMeasures(Measure* fm, Measure* lm, const Fraction& ns, int st
       range.fill(fill);
 
       for (Score* s : scoreList()) {
-            Measure* m1 = s->tick2measure(fm->tick());
-            Measure* m2 = s->tick2measure(lm->tick());
+            Measure* m1 = s->correspondingMeasure(fm);
+            Measure* m2 = s->correspondingMeasure(lm);
 
             Fraction tick1 = m1->tick();
             Fraction tick2 = m2->endTick();
@@ -922,7 +922,7 @@ void Score::cmdRemoveTimeSig(TimeSig* ts)
       // Delete the time sig segment from the root score, we will rewriteMeasures from it
       // since it contains all the music while the part doesn't
       Score* rScore = masterScore();
-      Measure* rm = rScore->tick2measure(m->tick());
+      Measure* rm = rScore->correspondingMeasure(m);
       Segment* rs = rm->findSegment(SegmentType::TimeSig, s->tick());
       rScore->undoRemoveElement(rs);
 
@@ -1841,7 +1841,7 @@ void Score::deleteItem(Element* el)
                         if (bl->barLineType() == BarLineType::START_REPEAT) {
                               Measure* m2 = m->isMMRest() ? m->mmRestFirst() : m;
                               for (Score* lscore : score()->scoreList()) {
-                                    Measure* lmeasure = lscore->tick2measure(m2->tick());
+                                    Measure* lmeasure = lscore->correspondingMeasure(m2);
                                     if (lmeasure)
                                           lmeasure->undoChangeProperty(Pid::REPEAT_START, false);
                                     }
@@ -1849,7 +1849,7 @@ void Score::deleteItem(Element* el)
                         else if (bl->barLineType() == BarLineType::END_REPEAT) {
                               Measure* m2 = m->isMMRest() ? m->mmRestLast() : m;
                               for (Score* lscore : score()->scoreList()) {
-                                    Measure* lmeasure = lscore->tick2measure(m2->tick());
+                                    Measure* lmeasure = lscore->correspondingMeasure(m2);
                                     if (lmeasure)
                                           lmeasure->undoChangeProperty(Pid::REPEAT_END, false);
                                     }
@@ -3935,9 +3935,7 @@ static Element* findLinkedVoiceElement(Element* e, Staff* nstaff)
 
       Score* score     = nstaff->score();
       Segment* segment = toSegment(e->parent());
-      Measure* measure = segment->measure();
-      Measure* m       = score->tick2measure(measure->tick());
-      Segment* s       = m->findSegment(segment->segmentType(), segment->tick());
+      Segment* s       = score->correspondingSegment(segment);
       return s->element(dtrack);
       }
 
@@ -3974,9 +3972,7 @@ static Chord* findLinkedChord(Chord* c, Staff* nstaff)
                   }
             }
 
-      Segment* s  = c->segment();
-      Measure* nm = nstaff->score()->tick2measure(s->tick());
-      Segment* ns = nm->findSegment(s->segmentType(), s->tick());
+      Segment* ns = nstaff->score()->correspondingSegment(c->segment());
       Element* ne = ns->element(dtrack);
       if (!ne->isChord())
             return 0;
@@ -4281,7 +4277,7 @@ void Score::undoAddElement(Element* element)
                         }
                   else if (et == ElementType::MARKER || et == ElementType::JUMP) {
                         Measure* om = toMeasure(element->parent());
-                        Measure* m  = score->tick2measure(om->tick());
+                        Measure* m  = score->correspondingMeasure(om);
                         ne->setTrack(element->track());
                         ne->setParent(m);
                         undo(new AddElement(ne));
@@ -4362,7 +4358,7 @@ void Score::undoAddElement(Element* element)
                         else {
                               Element* e = lb->linkedClone();
                               e->setScore(s);
-                              Measure* nm = s->tick2measure(m->tick());
+                              Measure* nm = s->correspondingMeasure(m);
                               e->setParent(nm);
                               undo(new AddElement(e));
                               }
@@ -4647,14 +4643,8 @@ void Score::undoAddElement(Element* element)
                         Tremolo* tremolo = toTremolo(element);
                         ChordRest* cr1 = toChordRest(tremolo->chord1());
                         ChordRest* cr2 = toChordRest(tremolo->chord2());
-                        Segment* s1    = cr1->segment();
-                        Segment* s2    = cr2->segment();
-                        Measure* m1    = s1->measure();
-                        Measure* m2    = s2->measure();
-                        Measure* nm1   = score->tick2measure(m1->tick());
-                        Measure* nm2   = score->tick2measure(m2->tick());
-                        Segment* ns1   = nm1->findSegment(s1->segmentType(), s1->tick());
-                        Segment* ns2   = nm2->findSegment(s2->segmentType(), s2->tick());
+                        Segment* ns1   = score->correspondingSegment(cr1->segment());
+                        Segment* ns2   = score->correspondingSegment(cr2->segment());
                         Chord* c1      = toChord(ns1->element(staffIdx * VOICES + cr1->voice()));
                         Chord* c2      = toChord(ns2->element(staffIdx * VOICES + cr2->voice()));
                         Tremolo* ntremolo = toTremolo(ne);
@@ -4670,10 +4660,7 @@ void Score::undoAddElement(Element* element)
                         }
                   else if (element->isArpeggio()) {
                         ChordRest* cr = toChordRest(element->parent());
-                        Segment* s    = cr->segment();
-                        Measure* m    = s->measure();
-                        Measure* nm   = score->tick2measure(m->tick());
-                        Segment* ns   = nm->findSegment(s->segmentType(), s->tick());
+                        Segment* ns   = score->correspondingSegment(cr->segment());
                         Chord* c1     = toChord(ns->element(staffIdx * VOICES + cr->voice()));
                         ne->setParent(c1);
                         undo(new AddElement(ne));
@@ -4706,9 +4693,7 @@ void Score::undoAddElement(Element* element)
                   else if (element->isInstrumentChange()) {
                         InstrumentChange* is = toInstrumentChange(element);
                         Segment* s1    = is->segment();
-                        Measure* m1    = s1->measure();
-                        Measure* nm1   = score->tick2measure(m1->tick());
-                        Segment* ns1   = nm1->findSegment(s1->segmentType(), s1->tick());
+                        Segment* ns1   = score->correspondingSegment(s1);
                         InstrumentChange* nis = toInstrumentChange(ne);
                         nis->setParent(ns1);
                         Fraction tickStart = nis->segment()->tick();
@@ -43,6 +43,8 @@
 #include "undo.h"
 #include "bracketItem.h"
 
+#include <QtConcurrent>
+
 namespace Ms {
 
 //---------------------------------------------------------
@@ -124,10 +126,12 @@ bool Excerpt::operator==(const Excerpt& e) const
       }
 
 //---------------------------------------------------------
-//   createExcerpt
+//   initPartScore
+//    create the parts and linked staves of the part score,
+//    returns the index of the source staff for each staff
 //---------------------------------------------------------
 
-void Excerpt::createExcerpt(Excerpt* excerpt)
+static QList<int> initPartScore(Excerpt* excerpt)
       {
       MasterScore* oscore = excerpt->oscore();
       Score* score        = excerpt->partScore();
@@ -189,8 +193,18 @@ void Excerpt::createExcerpt(Excerpt* excerpt)
                   }
             excerpt->setTracks(tracks);
             }
+      return srcStaves;
+      }
 
-      cloneStaves(oscore, score, srcStaves, excerpt->tracks());
+//---------------------------------------------------------
+//   layoutPartScore
+//    add the title frame, initial layout and transposition
+//---------------------------------------------------------
+
+static void layoutPartScore(Excerpt* excerpt)
+      {
+      MasterScore* oscore = excerpt->oscore();
+      Score* score        = excerpt->partScore();
 
       // create excerpt title and title frame for all scores if not already there
       MeasureBase* measure = oscore->first();
@@ -277,14 +291,78 @@ void Excerpt::createExcerpt(Excerpt* excerpt)
             //score->spatiumChanged(oscore->spatium(), score->spatium());
             score->styleChanged();
             }
+      score->setPlaylistDirty();
+      }
+
+//---------------------------------------------------------
+//   createExcerpt
+//---------------------------------------------------------
+
+void Excerpt::createExcerpt(Excerpt* excerpt)
+      {
+      createExcerpts(QList<Excerpt*>() << excerpt, false);
+      }
+
+//---------------------------------------------------------
+//   createExcerpts
+//    Create the part scores of excerpts, which must have
+//    their part score set.
+//    Cloning the staves is done for all excerpts at the
+//    same time if parallel is set. Each thread collects
+//    its undo commands in a DetachedCmd and link list
+//    changes are recorded; both are merged in excerpt
+//    order afterwards, so the result does not depend on
+//    the order in which the threads ran. Title frames and
+//    layout change the master score and are done one
+//    excerpt after the other.
+//---------------------------------------------------------
+
+void Excerpt::createExcerpts(const QList<Excerpt*>& excerpts, bool parallel)
+      {
+      if (excerpts.isEmpty())
+            return;
+      MasterScore* oscore = excerpts.front()->oscore();
+
+      QList<QList<int>> srcStaves;
+      for (Excerpt* e : excerpts)
+            srcStaves.append(initPartScore(e));
+
+      if (parallel && excerpts.size() > 1 && QThread::idealThreadCount() > 1) {
+            std::vector<std::unique_ptr<DetachedCmd>> cmds;
+            QList<int> indices;
+            for (int i = 0; i < excerpts.size(); ++i) {
+                  cmds.emplace_back(new DetachedCmd(excerpts[i]->partScore()));
+                  indices.append(i);
+                  }
+            oscore->measures()->measureIndex();   // build it here, the threads only read it
+            LinkedElements::beginRecording();
+            QtConcurrent::blockingMap(indices, [oscore, &excerpts, &srcStaves, &cmds](int i) {
+                  Excerpt* e = excerpts[i];
+                  LinkedElements::setRecordingRank(i);
+                  cmds[i]->begin();
+                  cloneStaves(oscore, e->partScore(), srcStaves[i], e->tracks());
+                  cmds[i]->end();
+                  });
+            LinkedElements::endRecording();
+            for (auto& cmd : cmds)
+                  cmd->merge(oscore);
+            }
+      else {
+            for (int i = 0; i < excerpts.size(); ++i)
+                  cloneStaves(oscore, excerpts[i]->partScore(), srcStaves[i], excerpts[i]->tracks());
+            }
+
+      for (Excerpt* e : excerpts)
+            layoutPartScore(e);
 
       // second layout of score
-      score->setPlaylistDirty();
       oscore->rebuildMidiMapping();
       oscore->updateChannel();
 
-      score->setLayoutAll();
-      score->doLayout();
+      for (Excerpt* e : excerpts) {
+            e->partScore()->setLayoutAll();
+            e->partScore()->doLayout();
+            }
       }
 
 //---------------------------------------------------------
@@ -365,7 +443,7 @@ static void cloneSpanner(Spanner* s, Score* score, int dstTrack, int dstTrack2)
             ns->setStartElement(0);
             ns->setEndElement(0);
             if (cr1 && cr1->links()) {
-                  for (ScoreElement* e : *cr1->links()) {
+                  for (ScoreElement* e : cr1->linkList()) {
                         ChordRest* cr = toChordRest(e);
                         if (cr == cr1)
                               continue;
@@ -376,7 +454,7 @@ static void cloneSpanner(Spanner* s, Score* score, int dstTrack, int dstTrack2)
                         }
                   }
             if (cr2 && cr2->links()) {
-                  for (ScoreElement* e : *cr2->links()) {
+                  for (ScoreElement* e : cr2->linkList()) {
                         ChordRest* cr = toChordRest(e);
                         if (cr == cr2)
                               continue;
@@ -1058,7 +1136,7 @@ void Excerpt::cloneStaff2(Staff* srcStaff, Staff* dstStaff, const Fraction& stic
 
 
       for (Measure* m = m1; m && (m != m2); m = m->nextMeasure()) {
-            Measure* nm = score->tick2measure(m->tick());
+            Measure* nm = score->correspondingMeasure(m);
             for (int srcTrack : map.keys()) {
                   TupletMap tupletMap;    // tuplets cannot cross measure boundaries
                   int dstTrack = map.value(srcTrack);
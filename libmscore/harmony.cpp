@@ -1012,23 +1012,7 @@ const ChordDescription* Harmony::descr() const
 const ChordDescription* Harmony::descr(const QString& name, const ParsedChord* pc) const
       {
       const ChordList* cl = score()->style().chordList();
-      const ChordDescription* match = 0;
-      if (cl) {
-            foreach (const ChordDescription& cd, *cl) {
-                  for (const QString& s : cd.names) {
-                        if (s == name)
-                              return &cd;
-                        else if (pc) {
-                              for (const ParsedChord& sParsed : cd.parsedChords) {
-                                    if (sParsed == *pc)
-                                          match = &cd;
-                                    }
-                              }
-                        }
-                  }
-            }
-      // exact match failed, so fall back on parsed match if one was found
-      return match;
+      return cl ? cl->description(name, pc) : 0;
       }
 
 //---------------------------------------------------------
@@ -1083,7 +1067,7 @@ const ChordDescription* Harmony::generateDescription()
       // remove parsed chord from description
       // so we will only match it literally in the future
       cd.parsedChords.clear();
-      return &*cl->insert(cd.id, cd);
+      return cl->addDescription(cd);
       }
 
 //---------------------------------------------------------
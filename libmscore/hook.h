@@ -14,6 +14,7 @@
 #define __HOOK_H__
 
 #include "symbol.h"
+#include "mempool.h"
 
 namespace Ms {
 
@@ -27,6 +28,8 @@ class Hook final : public Symbol {
       int _hookType;
 
    public:
+      MS_POOLED_ALLOCATION
+
       Hook(Score* = 0);
       virtual Hook* clone() const override        { return new Hook(*this); }
       virtual qreal mag() const override          { return parent()->mag(); }
@@ -684,6 +684,323 @@ bool loadInstrumentTemplates(const QString& instrTemplates)
       return true;
       }
 
+//---------------------------------------------------------
+//   instrument templates cache
+//    binary copy of the parsed instrument templates,
+//    bump INSTRUMENT_CACHE_VERSION on every change of
+//    the format
+//---------------------------------------------------------
+
+static const qint32 INSTRUMENT_CACHE_VERSION = 1;
+
+static QDataStream& operator<<(QDataStream& s, const StaffName& n)
+      {
+      return s << n.name() << qint32(n.pos());
+      }
+
+static QDataStream& operator>>(QDataStream& s, StaffName& n)
+      {
+      QString name;
+      qint32 pos;
+      s >> name >> pos;
+      n = StaffName(name, pos);
+      return s;
+      }
+
+static QDataStream& operator<<(QDataStream& s, const std::vector<MidiCoreEvent>& events)
+      {
+      s << quint32(events.size());
+      for (const MidiCoreEvent& e : events)
+            s << quint8(e.type()) << quint8(e.channel()) << quint8(e.dataA()) << quint8(e.dataB());
+      return s;
+      }
+
+static QDataStream& operator>>(QDataStream& s, std::vector<MidiCoreEvent>& events)
+      {
+      quint32 n;
+      s >> n;
+      events.clear();
+      for (quint32 i = 0; i < n && s.status() == QDataStream::Ok; ++i) {
+            quint8 type, channel, a, b;
+            s >> type >> channel >> a >> b;
+            events.push_back(MidiCoreEvent(type, channel, a, b));
+            }
+      return s;
+      }
+
+static QDataStream& operator<<(QDataStream& s, const NamedEventList& l)
+      {
+      return s << l.name << l.descr << l.events;
+      }
+
+static QDataStream& operator>>(QDataStream& s, NamedEventList& l)
+      {
+      return s >> l.name >> l.descr >> l.events;
+      }
+
+static QDataStream& operator<<(QDataStream& s, const MidiArticulation& a)
+      {
+      return s << a.name << a.descr << qint32(a.velocity) << qint32(a.gateTime);
+      }
+
+static QDataStream& operator>>(QDataStream& s, MidiArticulation& a)
+      {
+      qint32 velocity, gateTime;
+      s >> a.name >> a.descr >> velocity >> gateTime;
+      a.velocity = velocity;
+      a.gateTime = gateTime;
+      return s;
+      }
+
+static QDataStream& operator<<(QDataStream& s, const instrString& str)
+      {
+      return s << qint32(str.pitch) << str.open;
+      }
+
+static QDataStream& operator>>(QDataStream& s, instrString& str)
+      {
+      qint32 pitch;
+      s >> pitch >> str.open;
+      str.pitch = pitch;
+      return s;
+      }
+
+static QDataStream& operator<<(QDataStream& s, const DrumInstrumentVariant& v)
+      {
+      return s << qint32(v.pitch) << v.articulationName << qint32(v.tremolo);
+      }
+
+static QDataStream& operator>>(QDataStream& s, DrumInstrumentVariant& v)
+      {
+      qint32 pitch, tremolo;
+      s >> pitch >> v.articulationName >> tremolo;
+      v.pitch   = pitch;
+      v.tremolo = TremoloType(tremolo);
+      return s;
+      }
+
+static QDataStream& operator<<(QDataStream& s, const Channel& c)
+      {
+      s << c.name() << c.descr() << c.synti() << qint32(c.color())
+        << qint8(c.volume()) << qint8(c.pan()) << qint8(c.chorus()) << qint8(c.reverb())
+        << qint32(c.program()) << qint32(c.bank()) << qint32(c.channel())
+        << c.soloMute() << c.mute() << c.solo() << c.userBankController()
+        << c.initList() << c.midiActions << c.articulation;
+      return s;
+      }
+
+static QDataStream& operator>>(QDataStream& s, Channel& c)
+      {
+      QString name, descr, synti;
+      qint32 color, program, bank, channel;
+      qint8 volume, pan, chorus, reverb;
+      bool soloMute, mute, solo, userBankController;
+      std::vector<MidiCoreEvent> init;
+      s >> name >> descr >> synti >> color
+        >> volume >> pan >> chorus >> reverb
+        >> program >> bank >> channel
+        >> soloMute >> mute >> solo >> userBankController
+        >> init >> c.midiActions >> c.articulation;
+      c.setName(name);
+      c.setDescr(descr);
+      c.setSynti(synti);
+      c.setColor(color);
+      c.setVolume(volume);
+      c.setPan(pan);
+      c.setChorus(chorus);
+      c.setReverb(reverb);
+      c.setProgram(program);
+      c.setBank(bank);
+      c.setChannel(channel);
+      c.setSoloMute(soloMute);
+      c.setMute(mute);
+      c.setSolo(solo);
+      c.setUserBankController(userBankController);
+      c.initList() = init;    // keeps the additional controllers of the template
+      return s;
+      }
+
+//---------------------------------------------------------
+//   writeDrumset
+//---------------------------------------------------------
+
+static void writeDrumset(QDataStream& s, const Drumset* ds)
+      {
+      for (int i = 0; i < DRUM_INSTRUMENTS; ++i) {
+            const DrumInstrument& d = ds->drum(i);
+            s << d.name << qint32(d.notehead);
+            for (SymId id : d.noteheads)
+                  s << qint32(id);
+            s << qint32(d.line) << qint32(d.stemDirection) << qint32(d.voice) << qint8(d.shortcut) << d.variants;
+            }
+      }
+
+//---------------------------------------------------------
+//   readDrumset
+//---------------------------------------------------------
+
+static void readDrumset(QDataStream& s, Drumset* ds)
+      {
+      for (int i = 0; i < DRUM_INSTRUMENTS; ++i) {
+            DrumInstrument& d = ds->drum(i);
+            qint32 notehead, line, stemDirection, voice;
+            qint8 shortcut;
+            s >> d.name >> notehead;
+            for (SymId& id : d.noteheads) {
+                  qint32 sym;
+                  s >> sym;
+                  id = SymId(sym);
+                  }
+            s >> line >> stemDirection >> voice >> shortcut >> d.variants;
+            d.notehead      = NoteHead::Group(notehead);
+            d.line          = line;
+            d.stemDirection = Direction(stemDirection);
+            d.voice         = voice;
+            d.shortcut      = shortcut;
+            }
+      }
+
+//---------------------------------------------------------
+//   writeTemplate
+//---------------------------------------------------------
+
+static void writeTemplate(QDataStream& s, const InstrumentTemplate& t)
+      {
+      s << t.id << t.trackName << t.longNames << t.shortNames << t.musicXMLid << t.description
+        << qint8(t.minPitchA) << qint8(t.maxPitchA) << qint8(t.minPitchP) << qint8(t.maxPitchP)
+        << qint8(t.transpose.diatonic) << qint8(t.transpose.chromatic)
+        << qint32(t.staffGroup) << (t.staffTypePreset ? t.staffTypePreset->xmlName() : QString())
+        << t.useDrumset << bool(t.drumset);
+      if (t.drumset)
+            writeDrumset(s, t.drumset);
+      s << qint32(t.stringData.frets()) << t.stringData.stringList()
+        << t.midiActions << t.articulation << t.channel;
+      QStringList genres;
+      for (const InstrumentGenre* g : t.genres)
+            genres.append(g->id);
+      s << genres << qint32(t.nstaves());
+      for (int i = 0; i < MAX_STAVES; ++i) {
+            s << qint32(t.clefTypes[i]._concertClef) << qint32(t.clefTypes[i]._transposingClef)
+              << qint32(t.staffLines[i]) << qint32(t.bracket[i]) << qint32(t.bracketSpan[i])
+              << qint32(t.barlineSpan[i]) << t.smallStaff[i];
+            }
+      s << t.extended << t.singleNoteDynamics;
+      }
+
+//---------------------------------------------------------
+//   readTemplate
+//---------------------------------------------------------
+
+static void readTemplate(QDataStream& s, InstrumentTemplate& t)
+      {
+      qint8 minPitchA, maxPitchA, minPitchP, maxPitchP, diatonic, chromatic;
+      qint32 staffGroup;
+      QString staffTypePreset;
+      bool hasDrumset;
+      s >> t.id >> t.trackName >> t.longNames >> t.shortNames >> t.musicXMLid >> t.description
+        >> minPitchA >> maxPitchA >> minPitchP >> maxPitchP
+        >> diatonic >> chromatic
+        >> staffGroup >> staffTypePreset
+        >> t.useDrumset >> hasDrumset;
+      t.minPitchA           = minPitchA;
+      t.maxPitchA           = maxPitchA;
+      t.minPitchP           = minPitchP;
+      t.maxPitchP           = maxPitchP;
+      t.transpose.diatonic  = diatonic;
+      t.transpose.chromatic = chromatic;
+      t.staffGroup          = StaffGroup(staffGroup);
+      t.staffTypePreset     = staffTypePreset.isEmpty() ? 0 : StaffType::presetFromXmlName(staffTypePreset);
+      if (hasDrumset) {
+            t.drumset = new Drumset;
+            readDrumset(s, t.drumset);
+            }
+      qint32 frets;
+      s >> frets >> t.stringData.stringList()
+        >> t.midiActions >> t.articulation >> t.channel;
+      t.stringData.setFrets(frets);
+      QStringList genres;
+      qint32 staves;
+      s >> genres >> staves;
+      for (const QString& g : genres)
+            t.linkGenre(g);
+      t.setStaves(staves);
+      for (int i = 0; i < MAX_STAVES; ++i) {
+            qint32 concertClef, transposingClef, staffLines, bracket, bracketSpan, barlineSpan;
+            s >> concertClef >> transposingClef >> staffLines >> bracket >> bracketSpan
+              >> barlineSpan >> t.smallStaff[i];
+            t.clefTypes[i]._concertClef     = ClefType(concertClef);
+            t.clefTypes[i]._transposingClef = ClefType(transposingClef);
+            t.staffLines[i]  = staffLines;
+            t.bracket[i]     = BracketType(bracket);
+            t.bracketSpan[i] = bracketSpan;
+            t.barlineSpan[i] = barlineSpan;
+            }
+      s >> t.extended >> t.singleNoteDynamics;
+      }
+
+//---------------------------------------------------------
+//   saveInstrumentTemplatesCache
+//    write the loaded instrument templates to s
+//---------------------------------------------------------
+
+bool saveInstrumentTemplatesCache(QDataStream& s)
+      {
+      s << INSTRUMENT_CACHE_VERSION;
+      s << qint32(instrumentGenres.size());
+      for (const InstrumentGenre* g : instrumentGenres)
+            s << g->id << g->name;
+      s << articulation;
+      s << qint32(instrumentGroups.size());
+      for (const InstrumentGroup* g : instrumentGroups) {
+            s << g->id << g->name << g->extended << qint32(g->instrumentTemplates.size());
+            for (const InstrumentTemplate* t : g->instrumentTemplates)
+                  writeTemplate(s, *t);
+            }
+      return s.status() == QDataStream::Ok;
+      }
+
+//---------------------------------------------------------
+//   loadInstrumentTemplatesCache
+//    read instrument templates written by
+//    saveInstrumentTemplatesCache(); the templates are
+//    cleared on error
+//---------------------------------------------------------
+
+bool loadInstrumentTemplatesCache(QDataStream& s)
+      {
+      clearInstrumentTemplates();
+      qint32 version;
+      s >> version;
+      if (version != INSTRUMENT_CACHE_VERSION)
+            return false;
+
+      qint32 n;
+      s >> n;
+      for (int i = 0; i < n && s.status() == QDataStream::Ok; ++i) {
+            InstrumentGenre* genre = new InstrumentGenre;
+            s >> genre->id >> genre->name;
+            instrumentGenres.append(genre);
+            }
+      s >> articulation;
+      s >> n;
+      for (int i = 0; i < n && s.status() == QDataStream::Ok; ++i) {
+            InstrumentGroup* group = new InstrumentGroup;
+            qint32 templates;
+            s >> group->id >> group->name >> group->extended >> templates;
+            instrumentGroups.append(group);
+            for (int k = 0; k < templates && s.status() == QDataStream::Ok; ++k) {
+                  InstrumentTemplate* t = new InstrumentTemplate;
+                  readTemplate(s, *t);
+                  group->instrumentTemplates.append(t);
+                  }
+            }
+      if (s.status() != QDataStream::Ok) {
+            clearInstrumentTemplates();
+            return false;
+            }
+      return true;
+      }
+
 //---------------------------------------------------------
 //   searchTemplate
 //---------------------------------------------------------
@@ -124,6 +124,8 @@ extern QList<InstrumentGroup*> instrumentGroups;
 extern void clearInstrumentTemplates();
 extern bool loadInstrumentTemplates(const QString& instrTemplates);
 extern bool saveInstrumentTemplates(const QString& instrTemplates);
+extern bool loadInstrumentTemplatesCache(QDataStream&);
+extern bool saveInstrumentTemplatesCache(QDataStream&);
 extern InstrumentTemplate* searchTemplate(const QString& name);
 extern InstrumentTemplate* searchTemplateForMusicXmlId(const QString& mxmlId);
 extern ClefType defaultClef(int patch);
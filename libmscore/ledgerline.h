@@ -14,6 +14,7 @@
 #define __LEDGERLINE_H__
 
 #include "element.h"
+#include "mempool.h"
 
 namespace Ms {
 
@@ -35,6 +36,8 @@ class LedgerLine final : public Element {
       bool vertical { false };
 
    public:
+      MS_POOLED_ALLOCATION
+
       LedgerLine(Score*);
       LedgerLine &operator=(const LedgerLine&) = delete;
       virtual LedgerLine* clone() const override { return new LedgerLine(*this); }
@@ -79,6 +79,7 @@ class Measure final : public MeasureBase {
                               // counts how many times this measure was already played
 
       int _repeatCount;       ///< end repeat marker und repeat count
+      int _listIndex { -1 };  // position in MeasureBaseList::measureIndex()
 
       MeasureNumberMode _noMode;
       bool _breakMultiMeasureRest;
@@ -229,6 +230,8 @@ class Measure final : public MeasureBase {
 
       int playbackCount() const      { return _playbackCount; }
       void setPlaybackCount(int val) { _playbackCount = val; }
+      int listIndex() const          { return _listIndex; }
+      void setListIndex(int val)     { _listIndex = val; }
       QRectF staffabbox(int staffIdx) const;
 
       virtual QVariant getProperty(Pid propertyId) const override;
@@ -0,0 +1,166 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2019 Werner Schweer
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#include "mempool.h"
+
+#include <atomic>
+#include <new>
+
+namespace Ms {
+
+static const size_t GRANULARITY  = 16;      // size classes are multiples of this
+static const size_t SIZE_CLASSES = 64;      // pooled sizes up to GRANULARITY * SIZE_CLASSES
+static const int MAX_FREE_BLOCKS = 4096;    // per size class and thread
+
+static std::atomic<long long> allocations     { 0 };
+static std::atomic<long long> deallocations   { 0 };
+static std::atomic<long long> reused          { 0 };
+static std::atomic<long long> heapAllocations { 0 };
+
+//---------------------------------------------------------
+//   FreeBlock
+//---------------------------------------------------------
+
+struct FreeBlock {
+      FreeBlock* next;
+      };
+
+//---------------------------------------------------------
+//   FreeLists
+//    the free lists of one thread, blocks are returned to
+//    the heap when the thread ends. Objects can still be
+//    deleted after that, during static destruction or by
+//    other thread_local destructors; freeListsDestroyed
+//    (trivially destructible, so always accessible) sends
+//    them directly to the heap.
+//---------------------------------------------------------
+
+static thread_local bool freeListsDestroyed = false;
+
+struct FreeLists {
+      FreeBlock* list[SIZE_CLASSES] {};
+      int count[SIZE_CLASSES] {};
+
+      ~FreeLists() { clear(); freeListsDestroyed = true; }
+
+      void clear()
+            {
+            for (size_t i = 0; i < SIZE_CLASSES; ++i) {
+                  while (list[i]) {
+                        FreeBlock* b = list[i];
+                        list[i] = b->next;
+                        ::operator delete(b);
+                        }
+                  count[i] = 0;
+                  }
+            }
+      };
+
+static thread_local FreeLists freeLists;
+
+//---------------------------------------------------------
+//   sizeClass
+//    returns SIZE_CLASSES for blocks too large to be pooled
+//---------------------------------------------------------
+
+static inline size_t sizeClass(size_t size)
+      {
+      size_t idx = (size + GRANULARITY - 1) / GRANULARITY;
+      return idx == 0 ? 0 : idx - 1;
+      }
+
+//---------------------------------------------------------
+//   alloc
+//---------------------------------------------------------
+
+void* MemoryPool::alloc(size_t size)
+      {
+      allocations.fetch_add(1, std::memory_order_relaxed);
+      const size_t idx = sizeClass(size);
+      if (idx < SIZE_CLASSES) {
+            if (!freeListsDestroyed) {
+                  FreeLists& fl = freeLists;
+                  if (FreeBlock* b = fl.list[idx]) {
+                        fl.list[idx] = b->next;
+                        --fl.count[idx];
+                        reused.fetch_add(1, std::memory_order_relaxed);
+                        return b;
+                        }
+                  }
+            size = (idx + 1) * GRANULARITY;
+            }
+      heapAllocations.fetch_add(1, std::memory_order_relaxed);
+      return ::operator new(size);
+      }
+
+//---------------------------------------------------------
+//   free
+//---------------------------------------------------------
+
+void MemoryPool::free(void* p, size_t size)
+      {
+      if (!p)
+            return;
+      deallocations.fetch_add(1, std::memory_order_relaxed);
+      const size_t idx = sizeClass(size);
+      if (idx < SIZE_CLASSES && !freeListsDestroyed) {
+            FreeLists& fl = freeLists;
+            if (fl.count[idx] < MAX_FREE_BLOCKS) {
+                  FreeBlock* b = static_cast<FreeBlock*>(p);
+                  b->next = fl.list[idx];
+                  fl.list[idx] = b;
+                  ++fl.count[idx];
+                  return;
+                  }
+            }
+      ::operator delete(p);
+      }
+
+//---------------------------------------------------------
+//   trim
+//    return the free blocks of the calling thread
+//    to the heap
+//---------------------------------------------------------
+
+void MemoryPool::trim()
+      {
+      if (!freeListsDestroyed)
+            freeLists.clear();
+      }
+
+//---------------------------------------------------------
+//   statistics
+//---------------------------------------------------------
+
+MemoryPool::Statistics MemoryPool::statistics()
+      {
+      Statistics s;
+      s.allocations     = allocations.load(std::memory_order_relaxed);
+      s.deallocations   = deallocations.load(std::memory_order_relaxed);
+      s.reused          = reused.load(std::memory_order_relaxed);
+      s.heapAllocations = heapAllocations.load(std::memory_order_relaxed);
+      return s;
+      }
+
+//---------------------------------------------------------
+//   resetStatistics
+//---------------------------------------------------------
+
+void MemoryPool::resetStatistics()
+      {
+      allocations     = 0;
+      deallocations   = 0;
+      reused          = 0;
+      heapAllocations = 0;
+      }
+
+}
@@ -0,0 +1,60 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2019 Werner Schweer
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#ifndef __MEMPOOL_H__
+#define __MEMPOOL_H__
+
+#include <cstddef>
+
+namespace Ms {
+
+//---------------------------------------------------------
+//   MemoryPool
+//    Free list allocator for elements which are created
+//    and deleted in large numbers by every layout (systems,
+//    pages, spanner segments, stems, hooks, ledger lines).
+//    Freed blocks are kept in per thread free lists, one
+//    for every size class, and are reused by the next
+//    allocation of the same size class.
+//---------------------------------------------------------
+
+class MemoryPool {
+   public:
+      struct Statistics {
+            long long allocations   { 0 };    // calls to alloc()
+            long long deallocations { 0 };    // calls to free()
+            long long reused        { 0 };    // allocations served from a free list
+            long long heapAllocations { 0 };  // allocations passed to the heap
+            long long live() const { return allocations - deallocations; }
+            };
+
+      static void* alloc(size_t size);
+      static void free(void* p, size_t size);
+      static void trim();
+
+      static Statistics statistics();
+      static void resetStatistics();
+      };
+
+//---------------------------------------------------------
+//   MS_POOLED_ALLOCATION
+//    Add to the declaration of a class to allocate its
+//    instances from the MemoryPool. The class must have a
+//    virtual destructor if it has subclasses.
+//---------------------------------------------------------
+
+#define MS_POOLED_ALLOCATION \
+      static void* operator new(size_t size)            { return Ms::MemoryPool::alloc(size); } \
+      static void operator delete(void* p, size_t size) { Ms::MemoryPool::free(p, size);     }
+
+}     // namespace Ms
+#endif
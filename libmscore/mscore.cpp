@@ -101,6 +101,7 @@ qreal   MScore::nudgeStep;
 qreal   MScore::nudgeStep10;
 qreal   MScore::nudgeStep50;
 int     MScore::defaultPlayDuration;
+int     MScore::undoMemoryLimit;
 
 QString MScore::lastError;
 int     MScore::division    = 480; // 3840;   // pulses per quarter note (PPQ) // ticks per beat
@@ -301,6 +302,7 @@ void MScore::init()
       defaultColor        = Qt::black;
       dropColor           = QColor("#1778db");
       defaultPlayDuration = 300;      // ms
+      undoMemoryLimit     = 0;        // MB
       warnPitchRange      = true;
       playRepeats         = true;
       panPlayback         = true;
@@ -93,6 +93,7 @@ static const int  SHADOW_NOTE_LIGHT       = 135;
 static const char mimeSymbolFormat[]      = "application/musescore/symbol";
 static const char mimeSymbolListFormat[]  = "application/musescore/symbollist";
 static const char mimeStaffListFormat[]   = "application/musescore/stafflist";
+static const char mimeStaffListBinaryFormat[] = "application/musescore/stafflist-binary";
 
 static const int  VISUAL_STRING_NONE      = -100;     // no ordinal for the visual repres. of string (topmost in TAB
                                                       // varies according to visual order and presence of bass strings)
@@ -338,6 +339,7 @@ class MScore {
       static qreal nudgeStep10;
       static qreal nudgeStep50;
       static int defaultPlayDuration;
+      static int undoMemoryLimit;         // MB, 0: unlimited
       static QString lastError;
 
 // #ifndef NDEBUG
@@ -15,6 +15,7 @@
 
 #include "config.h"
 #include "element.h"
+#include "mempool.h"
 #include "bsp.h"
 
 namespace Ms {
@@ -44,6 +45,8 @@ class Page final : public Element {
       void drawHeaderFooter(QPainter*, int area, const QString&) const;
 
    public:
+      MS_POOLED_ALLOCATION
+
       Page(Score*);
       ~Page();
       virtual Page* clone() const           { return new Page(*this); }
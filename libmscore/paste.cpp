@@ -1004,8 +1004,10 @@ void Score::cmdPaste(const QMimeData* ms, MuseScoreView* view, Fraction scale)
                         delete nel;
                   }
             }
-      else if ((_selection.isRange() || _selection.isList()) && ms->hasFormat(mimeStaffListFormat)) {
+      else if ((_selection.isRange() || _selection.isList())
+         && (ms->hasFormat(mimeStaffListBinaryFormat) || ms->hasFormat(mimeStaffListFormat))) {
             ChordRest* cr = 0;
+            XmlTokens tokens;
             if (_selection.isRange())
                   cr = _selection.firstChordRest();
             else if (_selection.isSingle()) {
@@ -1027,6 +1029,13 @@ void Score::cmdPaste(const QMimeData* ms, MuseScoreView* view, Fraction scale)
                   MScore::setError(DEST_TUPLET);
                   return;
                   }
+            else if (ms->hasFormat(mimeStaffListBinaryFormat) && tokens.fromByteArray(ms->data(mimeStaffListBinaryFormat))) {
+                  // internal format: no xml text to parse
+                  XmlReader e(&tokens);
+                  e.setPasteMode(true);
+                  if (!pasteStaff(e, cr->segment(), cr->staffIdx(), scale))
+                        return;
+                  }
             else {
                   QByteArray data(ms->data(mimeStaffListFormat));
                   if (MScore::debugMode)
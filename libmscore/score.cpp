@@ -101,6 +101,7 @@ MeasureBaseList::MeasureBaseList()
 
 void MeasureBaseList::push_back(MeasureBase* e)
       {
+      invalidateIndex();
       ++_size;
       if (_last) {
             _last->setNext(e);
@@ -121,6 +122,7 @@ void MeasureBaseList::push_back(MeasureBase* e)
 
 void MeasureBaseList::push_front(MeasureBase* e)
       {
+      invalidateIndex();
       ++_size;
       if (_first) {
             _first->setPrev(e);
@@ -155,6 +157,7 @@ void MeasureBaseList::add(MeasureBase* e)
       e->setPrev(el->prev());
       el->prev()->setNext(e);
       el->setPrev(e);
+      invalidateIndex();
       }
 
 //---------------------------------------------------------
@@ -163,6 +166,7 @@ void MeasureBaseList::add(MeasureBase* e)
 
 void MeasureBaseList::remove(MeasureBase* el)
       {
+      invalidateIndex();
       --_size;
       if (el->prev())
             el->prev()->setNext(el->next());
@@ -180,6 +184,7 @@ void MeasureBaseList::remove(MeasureBase* el)
 
 void MeasureBaseList::insert(MeasureBase* fm, MeasureBase* lm)
       {
+      invalidateIndex();
       ++_size;
       for (MeasureBase* m = fm; m != lm; m = m->next())
             ++_size;
@@ -201,6 +206,7 @@ void MeasureBaseList::insert(MeasureBase* fm, MeasureBase* lm)
 
 void MeasureBaseList::remove(MeasureBase* fm, MeasureBase* lm)
       {
+      invalidateIndex();
       --_size;
       for (MeasureBase* m = fm; m != lm; m = m->next())
             --_size;
@@ -222,6 +228,7 @@ void MeasureBaseList::remove(MeasureBase* fm, MeasureBase* lm)
 
 void MeasureBaseList::change(MeasureBase* ob, MeasureBase* nb)
       {
+      invalidateIndex();
       nb->setPrev(ob->prev());
       nb->setNext(ob->next());
       if (ob->prev())
@@ -239,6 +246,28 @@ void MeasureBaseList::change(MeasureBase* ob, MeasureBase* nb)
             e->setParent(nb);
       }
 
+//---------------------------------------------------------
+//   measureIndex
+//    Measures of the list in order, each measure knows
+//    its position by Measure::listIndex()
+//---------------------------------------------------------
+
+const std::vector<Measure*>& MeasureBaseList::measureIndex() const
+      {
+      if (_measureIndexDirty) {
+            _measureIndex.clear();
+            for (MeasureBase* mb = _first; mb; mb = mb->next()) {
+                  if (mb->isMeasure()) {
+                        Measure* m = toMeasure(mb);
+                        m->setListIndex(int(_measureIndex.size()));
+                        _measureIndex.push_back(m);
+                        }
+                  }
+            _measureIndexDirty = false;
+            }
+      return _measureIndex;
+      }
+
 //---------------------------------------------------------
 //   Score
 //---------------------------------------------------------
@@ -845,6 +874,10 @@ void Score::setPlaylistDirty()
 
 void MasterScore::setPlaylistDirty()
       {
+      if (DetachedCmd* dc = DetachedCmd::current()) {
+            dc->setPlaylistDirty();
+            return;
+            }
       _playlistDirty = true;
       _repeatList->setScoreChanged();
       }
@@ -3615,6 +3648,52 @@ void Score::undo(UndoCommand* cmd, EditData* ed) const
       undoStack()->push(cmd, ed);
       }
 
+//---------------------------------------------------------
+//   DetachedCmd
+//---------------------------------------------------------
+
+thread_local DetachedCmd* DetachedCmd::_current;
+
+DetachedCmd::DetachedCmd(Score* score)
+      {
+      _undo = new UndoStack;
+      _undo->beginMacro(score);
+      }
+
+DetachedCmd::~DetachedCmd()
+      {
+      Q_ASSERT(_current != this);
+      // commands which were not merged are already executed,
+      // drop them like UndoStack::push() does outside of a command
+      _undo->endMacro(true);
+      delete _undo;
+      }
+
+//---------------------------------------------------------
+//   merge
+//    append the collected commands to the current command
+//    of score and add the layout range, flags and changes
+//    to its command state, must not be called on the
+//    worker thread
+//---------------------------------------------------------
+
+void DetachedCmd::merge(MasterScore* score)
+      {
+      Q_ASSERT(_current != this);
+      score->cmdState().merge(_cmdState);
+      if (_playlistDirty)
+            score->setPlaylistDirty();
+      UndoMacro* target = score->undoStack()->current();
+      if (!target)
+            return;
+      UndoMacro* macro = _undo->current();
+      std::vector<UndoCommand*> cl;
+      while (macro->childCount())
+            cl.push_back(macro->removeChild());
+      for (auto i = cl.rbegin(); i != cl.rend(); ++i)
+            target->appendChild(*i);
+      }
+
 //---------------------------------------------------------
 //   linkId
 //---------------------------------------------------------
@@ -4630,7 +4709,7 @@ int Score::staffIdx(const Part* part) const
 
 void MasterScore::setUpdateAll()
       {
-      _cmdState.setUpdateMode(UpdateMode::UpdateAll);
+      cmdState().setUpdateMode(UpdateMode::UpdateAll);
       }
 
 //---------------------------------------------------------
@@ -4639,17 +4718,17 @@ void MasterScore::setUpdateAll()
 
 void MasterScore::setLayoutAll(int staff, const Element* e)
       {
-      _cmdState.setTick(Fraction(0,1));
-      _cmdState.setTick(measures()->last() ? measures()->last()->endTick() : Fraction(0,1));
+      cmdState().setTick(Fraction(0,1));
+      cmdState().setTick(measures()->last() ? measures()->last()->endTick() : Fraction(0,1));
 
       if (e && e->score() == this) {
             // TODO: map staff number properly
             const int startStaff = staff == -1 ? 0 : staff;
             const int endStaff = staff == -1 ? (nstaves() - 1) : staff;
-            _cmdState.setStaff(startStaff);
-            _cmdState.setStaff(endStaff);
+            cmdState().setStaff(startStaff);
+            cmdState().setStaff(endStaff);
 
-            _cmdState.setElement(e);
+            cmdState().setElement(e);
             }
       }
 
@@ -4660,28 +4739,28 @@ void MasterScore::setLayoutAll(int staff, const Element* e)
 void MasterScore::setLayout(const Fraction& t, int staff, const Element* e)
       {
       if (t >= Fraction(0,1))
-            _cmdState.setTick(t);
+            cmdState().setTick(t);
 
       if (e && e->score() == this) {
             // TODO: map staff number properly
-            _cmdState.setStaff(staff);
-            _cmdState.setElement(e);
+            cmdState().setStaff(staff);
+            cmdState().setElement(e);
             }
       }
 
 void MasterScore::setLayout(const Fraction& tick1, const Fraction& tick2, int staff1, int staff2, const Element* e)
       {
       if (tick1 >= Fraction(0,1))
-            _cmdState.setTick(tick1);
+            cmdState().setTick(tick1);
       if (tick2 >= Fraction(0,1))
-            _cmdState.setTick(tick2);
+            cmdState().setTick(tick2);
 
       if (e && e->score() == this) {
             // TODO: map staff number properly
-            _cmdState.setStaff(staff1);
-            _cmdState.setStaff(staff2);
+            cmdState().setStaff(staff1);
+            cmdState().setStaff(staff2);
 
-            _cmdState.setElement(e);
+            cmdState().setElement(e);
             }
       }
 
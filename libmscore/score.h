@@ -132,27 +132,35 @@ enum class LayoutMode : char {
 
 //---------------------------------------------------------
 //   MeasureBaseList
+//    _measureIndex holds the Measures of the list in order
+//    and is rebuilt on first use after the list changed.
+//    Scores linked by parts have the same measures, so a
+//    measure is found in another score at the same index.
 //---------------------------------------------------------
 
 class MeasureBaseList {
       int _size;
       MeasureBase* _first;
       MeasureBase* _last;
+      mutable std::vector<Measure*> _measureIndex;
+      mutable bool _measureIndexDirty { true };
 
       void push_back(MeasureBase* e);
       void push_front(MeasureBase* e);
+      void invalidateIndex()     { _measureIndexDirty = true; }
 
    public:
       MeasureBaseList();
       MeasureBase* first() const { return _first; }
       MeasureBase* last()  const { return _last; }
-      void clear()               { _first = _last = 0; _size = 0; }
+      void clear()               { _first = _last = 0; _size = 0; invalidateIndex(); }
       void add(MeasureBase*);
       void remove(MeasureBase*);
       void insert(MeasureBase*, MeasureBase*);
       void remove(MeasureBase*, MeasureBase*);
       void change(MeasureBase* o, MeasureBase* n);
       int size() const { return _size; }
+      const std::vector<Measure*>& measureIndex() const;
       };
 
 //---------------------------------------------------------
@@ -275,6 +283,7 @@ class CmdState {
       UpdateMode updateMode() const { return _updateMode; }
       void setUpdateMode(UpdateMode m);
       void _setUpdateMode(UpdateMode m);
+      void merge(const CmdState&);
       bool layoutRange() const { return _updateMode == UpdateMode::Layout; }
       bool updateAll() const   { return int(_updateMode) >= int(UpdateMode::UpdateAll); }
       bool updateRange() const { return _updateMode == UpdateMode::Update; }
@@ -295,6 +304,40 @@ class CmdState {
 #endif
       };
 
+//---------------------------------------------------------
+//   DetachedCmd
+//    Stands in for the current command of the master
+//    score on a worker thread. Between begin() and end()
+//    undo commands and command state changes of the
+//    thread go to it instead of the master score, so that
+//    several part scores can be built at the same time
+//    (see Excerpt::createExcerpts()). merge() hands the
+//    commands to the real undo stack and the command
+//    state to the master score afterwards.
+//---------------------------------------------------------
+
+class DetachedCmd {
+      static thread_local DetachedCmd* _current;
+
+      DetachedCmd* _prev { 0 };
+      UndoStack* _undo;
+      CmdState _cmdState;
+      bool _playlistDirty { false };
+
+   public:
+      DetachedCmd(Score*);
+      ~DetachedCmd();
+      static DetachedCmd* current()     { return _current;       }
+
+      void begin()                      { _prev = _current; _current = this; }
+      void end()                        { _current = _prev;      }
+
+      UndoStack* undoStack() const      { return _undo;          }
+      CmdState& cmdState()              { return _cmdState;      }
+      void setPlaylistDirty()           { _playlistDirty = true; }
+      void merge(MasterScore*);
+      };
+
 //---------------------------------------------------------
 //   UpdateState
 //---------------------------------------------------------
@@ -799,6 +842,8 @@ class Score : public QObject, public ScoreElement {
 
       Fraction pos();
       Measure* tick2measure(const Fraction& tick) const;
+      Measure* correspondingMeasure(const Measure*) const;
+      Segment* correspondingSegment(const Segment*) const;
       Measure* tick2measureMM(const Fraction& tick) const;
       MeasureBase* tick2measureBase(const Fraction& tick) const;
       Segment* tick2segment(const Fraction& tick, bool first, SegmentType st, bool useMMrest = false) const;
@@ -1265,7 +1310,7 @@ class MasterScore : public Score {
       virtual bool isMaster() const override                          { return true;        }
       virtual bool readOnly() const override                          { return _readOnly;   }
       void setReadOnly(bool ro)                                       { _readOnly = ro;     }
-      virtual UndoStack* undoStack() const override                   { return _movements->undo(); }
+      virtual UndoStack* undoStack() const override                   { return DetachedCmd::current() ? DetachedCmd::current()->undoStack() : _movements->undo(); }
       virtual TimeSigMap* sigmap() const override                     { return _sigmap;     }
       virtual TempoMap* tempomap() const override                     { return _tempomap;   }
 
@@ -1295,10 +1340,10 @@ class MasterScore : public Score {
       void setLayout(const Fraction& tick, int staff, const Element* e = nullptr);
       void setLayout(const Fraction& tick1, const Fraction& tick2, int staff1, int staff2, const Element* e = nullptr);
 
-      virtual CmdState& cmdState() override                           { return _cmdState;                     }
-      const CmdState& cmdState() const override                       { return _cmdState;                     }
-      virtual void addLayoutFlags(LayoutFlags val) override           { _cmdState.layoutFlags |= val;         }
-      virtual void setInstrumentsChanged(bool val) override           { _cmdState._instrumentsChanged = val;  }
+      virtual CmdState& cmdState() override                           { return DetachedCmd::current() ? DetachedCmd::current()->cmdState() : _cmdState; }
+      const CmdState& cmdState() const override                       { return DetachedCmd::current() ? DetachedCmd::current()->cmdState() : _cmdState; }
+      virtual void addLayoutFlags(LayoutFlags val) override           { cmdState().layoutFlags |= val;        }
+      virtual void setInstrumentsChanged(bool val) override           { cmdState()._instrumentsChanged = val; }
 
       void setExcerptsChanged(bool val)                               { _cmdState._excerptsChanged = val;     }
       bool excerptsChanged() const                                    { return _cmdState._excerptsChanged;    }
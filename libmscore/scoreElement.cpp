@@ -23,6 +23,45 @@ namespace Ms {
 
 ElementStyle const ScoreElement::emptyStyle;
 
+QMutex linkMutex;
+
+//---------------------------------------------------------
+//   LinkRecording
+//    While part scores are cloned in parallel the threads
+//    append to shared link lists in no particular order.
+//    The recording remembers which thread (rank) added an
+//    element so that LinkedElements::endRecording() can
+//    restore the order and the link ids a sequential run
+//    would have produced.
+//---------------------------------------------------------
+
+struct LinkRecording {
+      struct List {
+            int fixed;        // leading entries which are not reordered
+            int serial;       // tells reused list addresses apart
+            bool created;     // list was created while recording
+            };
+      QHash<const LinkedElements*, List> lists;
+      QHash<const ScoreElement*, int> ranks;
+      std::vector<std::vector<std::pair<LinkedElements*, int>>> used;   // new lists in order of use, per rank
+      int serial { 0 };
+
+      void use(LinkedElements* le, const List& l, int rank) {
+            if (int(used.size()) <= rank)
+                  used.resize(rank + 1);
+            used[rank].push_back(std::make_pair(le, l.serial));
+            }
+      void create(LinkedElements* le, int rank) {
+            // the element linked to is added first and stays in front
+            List l { 1, serial++, true };
+            lists.insert(le, l);
+            use(le, l, rank);
+            }
+      };
+
+static LinkRecording* recording;
+static thread_local int recordingRank;
+
 //
 // list has to be synchronized with ElementType enum
 //
@@ -159,7 +198,8 @@ ScoreElement::ScoreElement(const ScoreElement& se)
 ScoreElement::~ScoreElement()
       {
       if (_links) {
-            _links->removeOne(this);
+            QMutexLocker locker(&linkMutex);
+            _links->removeLink(this);
             if (_links->empty()) {
                   delete _links;
                   _links = 0;
@@ -260,7 +300,7 @@ static void changeProperty(ScoreElement* e, Pid t, const QVariant& st, PropertyF
                   e->score()->undo(new ChangeBracketProperty(bi->staff(), bi->column(), t, st, ps));
                   }
             else
-                  e->score()->undo(new ChangeProperty(e, t, st, ps));
+                  e->score()->undoStack()->pushProperty(e, t, st, ps);
             }
       }
 
@@ -538,6 +578,7 @@ void ScoreElement::linkTo(ScoreElement* element)
       Q_ASSERT(element != this);
       Q_ASSERT(!_links);
 
+      QMutexLocker locker(&linkMutex);
       if (element->links()) {
             _links = element->_links;
             Q_ASSERT(_links->contains(element));
@@ -547,11 +588,11 @@ void ScoreElement::linkTo(ScoreElement* element)
                   _links = new LinkedElements(score(), -1); // don’t use lid
             else
                   _links = new LinkedElements(score());
-            _links->append(element);
+            _links->addLink(element);
             element->_links = _links;
             }
       Q_ASSERT(!_links->contains(this));
-      _links->append(this);
+      _links->addLink(this);
       }
 
 //---------------------------------------------------------
@@ -561,8 +602,9 @@ void ScoreElement::linkTo(ScoreElement* element)
 void ScoreElement::unlink()
       {
       Q_ASSERT(_links);
+      QMutexLocker locker(&linkMutex);
       Q_ASSERT(_links->contains(this));
-      _links->removeOne(this);
+      _links->removeLink(this);
 
       // if link list is empty, remove list
       if (_links->size() <= 1) {
@@ -601,8 +643,10 @@ void ScoreElement::undoUnlink()
 QList<ScoreElement*> ScoreElement::linkList() const
       {
       QList<ScoreElement*> el;
-      if (_links)
+      if (_links) {
+            QMutexLocker locker(&linkMutex);
             el = *_links;
+            }
       else
             el.append(const_cast<ScoreElement*>(this));
       return el;
@@ -615,6 +659,8 @@ QList<ScoreElement*> ScoreElement::linkList() const
 LinkedElements::LinkedElements(Score* score)
       {
       _lid = score->linkId(); // create new unique id
+      if (recording)
+            recording->create(this, recordingRank);
       }
 
 LinkedElements::LinkedElements(Score* score, int id)
@@ -622,6 +668,111 @@ LinkedElements::LinkedElements(Score* score, int id)
       _lid = id;
       if (_lid != -1)
             score->linkId(id);      // remember used id
+      if (recording)
+            recording->create(this, recordingRank);
+      }
+
+LinkedElements::~LinkedElements()
+      {
+      if (recording)
+            recording->lists.remove(this);
+      }
+
+//---------------------------------------------------------
+//   addLink
+//    append e, called with linkMutex held
+//---------------------------------------------------------
+
+void LinkedElements::addLink(ScoreElement* e)
+      {
+      if (recording) {
+            auto i = recording->lists.find(this);
+            if (i == recording->lists.end())
+                  i = recording->lists.insert(this, LinkRecording::List { size(), recording->serial++, false });
+            else if (i->created)
+                  recording->use(this, *i, recordingRank);
+            recording->ranks.insert(e, recordingRank);
+            }
+      append(e);
+      }
+
+//---------------------------------------------------------
+//   removeLink
+//    remove e, called with linkMutex held
+//---------------------------------------------------------
+
+void LinkedElements::removeLink(ScoreElement* e)
+      {
+      if (recording) {
+            auto i = recording->lists.find(this);
+            const int idx = indexOf(e);
+            if (i != recording->lists.end() && idx != -1 && idx < i->fixed)
+                  --i->fixed;
+            }
+      removeOne(e);
+      }
+
+//---------------------------------------------------------
+//   beginRecording
+//    start recording link list changes, no other thread
+//    may use links at this time
+//---------------------------------------------------------
+
+void LinkedElements::beginRecording()
+      {
+      Q_ASSERT(!recording);
+      recording = new LinkRecording;
+      }
+
+//---------------------------------------------------------
+//   setRecordingRank
+//    set the position of the current thread's changes in
+//    the sequential order
+//---------------------------------------------------------
+
+void LinkedElements::setRecordingRank(int rank)
+      {
+      recordingRank = rank;
+      }
+
+//---------------------------------------------------------
+//   endRecording
+//    sort the elements appended to each list by rank and
+//    give new lists their ids in order of first use by
+//    rank; called after all threads have finished
+//---------------------------------------------------------
+
+void LinkedElements::endRecording()
+      {
+      LinkRecording* r = recording;
+      recording = nullptr;
+      if (!r)
+            return;
+
+      std::vector<int> ids;
+      for (auto i = r->lists.begin(); i != r->lists.end(); ++i) {
+            LinkedElements* le = const_cast<LinkedElements*>(i.key());
+            const int fixed = qBound(0, i->fixed, le->size());
+            std::stable_sort(le->begin() + fixed, le->end(), [r](const ScoreElement* a, const ScoreElement* b) {
+                  return r->ranks.value(a) < r->ranks.value(b);
+                  });
+            if (i->created && le->_lid != -1)
+                  ids.push_back(le->_lid);
+            }
+
+      std::sort(ids.begin(), ids.end());
+      size_t next = 0;
+      QSet<const LinkedElements*> done;
+      for (const auto& rank : r->used) {
+            for (const auto& u : rank) {
+                  auto i = r->lists.constFind(u.first);
+                  if (i == r->lists.constEnd() || i->serial != u.second || u.first->_lid == -1 || done.contains(u.first))
+                        continue;
+                  done.insert(u.first);
+                  u.first->_lid = ids[next++];
+                  }
+            }
+      delete r;
       }
 
 //---------------------------------------------------------
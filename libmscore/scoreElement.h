@@ -140,19 +140,33 @@ enum class Sid : int;
 
 //---------------------------------------------------------
 //   LinkedElements
+//    Link lists are shared by the master score and its
+//    parts. Part scores can be built from several threads
+//    (Excerpt::createExcerpts()), so lists are created and
+//    changed with linkMutex held.
 //---------------------------------------------------------
 
+extern QMutex linkMutex;
+
 class LinkedElements : public QList<ScoreElement*> {
       int _lid;         // unique id for every linked list
 
    public:
       LinkedElements(Score*);
       LinkedElements(Score*, int id);
+      ~LinkedElements();
 
       void setLid(Score*, int val);
       int lid() const   { return _lid;    }
 
       ScoreElement* mainElement();
+
+      void addLink(ScoreElement*);
+      void removeLink(ScoreElement*);
+
+      static void beginRecording();
+      static void setRecordingRank(int);
+      static void endRecording();
       };
 
 //---------------------------------------------------------
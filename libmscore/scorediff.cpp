@@ -42,7 +42,28 @@ class MscxModeDiff {
             Tag(int l, TagType t, const QString& n) : line(l), type(t), name(n) {}
             };
 
+      //---------------------------------------------------------
+      //   Chunk
+      //    A range of MSCX lines compared as a whole: either a
+      //    complete <Measure> block or a single line outside of
+      //    measures. Identical measures are matched by their
+      //    content hash without being diffed line by line.
+      //---------------------------------------------------------
+
+      struct Chunk {
+            const std::vector<QStringRef>* lines = nullptr;
+            int first = 0;
+            int count = 0;
+            uint hash = 0;
+
+            bool operator==(const Chunk& other) const;
+            };
+
+      typedef std::vector<std::pair<QStringRef, dtl::edit_t>> LineEdits;
+
       static DiffType fromDtlDiffType(dtl::edit_t dtlType);
+      static std::vector<Chunk> splitChunks(const std::vector<QStringRef>& lines);
+      static void appendLineEdits(const std::vector<QStringRef>& lines1, const std::vector<QStringRef>& lines2, LineEdits& edits);
 
       void adjustSemanticsMscx(std::vector<TextDiff>&);
       int adjustSemanticsMscxOneDiff(std::vector<TextDiff>& diffs, int index);
@@ -111,34 +132,133 @@ DiffType MscxModeDiff::fromDtlDiffType(dtl::edit_t dtlType)
       return DiffType::EQUAL;
       }
 
+//---------------------------------------------------------
+//   MscxModeDiff::Chunk::operator==
+//---------------------------------------------------------
+
+bool MscxModeDiff::Chunk::operator==(const Chunk& other) const
+      {
+      if (hash != other.hash || count != other.count)
+            return false;
+      for (int i = 0; i < count; ++i) {
+            if ((*lines)[first + i] != (*other.lines)[other.first + i])
+                  return false;
+            }
+      return true;
+      }
+
+//---------------------------------------------------------
+//   MscxModeDiff::splitChunks
+//---------------------------------------------------------
+
+std::vector<MscxModeDiff::Chunk> MscxModeDiff::splitChunks(const std::vector<QStringRef>& lines)
+      {
+      std::vector<Chunk> chunks;
+      const int n = int(lines.size());
+      for (int i = 0; i < n; ++i) {
+            Chunk c;
+            c.lines = &lines;
+            c.first = i;
+            c.count = 1;
+            c.hash = qHash(lines[i]);
+            const QStringRef tag = lines[i].trimmed();
+            if (tag.startsWith("<Measure") && !tag.endsWith("/>")) {
+                  int end = i + 1;
+                  while (end < n && lines[end].trimmed() != "</Measure>")
+                        ++end;
+                  if (end < n) {
+                        for (int k = i + 1; k <= end; ++k)
+                              c.hash = 31 * c.hash + qHash(lines[k]);
+                        c.count = end - i + 1;
+                        i = end;
+                        }
+                  }
+            chunks.push_back(c);
+            }
+      return chunks;
+      }
+
+//---------------------------------------------------------
+//   MscxModeDiff::appendLineEdits
+//    Runs a line diff on the given lines and appends the
+//    resulting edit script to edits.
+//---------------------------------------------------------
+
+void MscxModeDiff::appendLineEdits(const std::vector<QStringRef>& lines1, const std::vector<QStringRef>& lines2, LineEdits& edits)
+      {
+      if (lines1.empty() || lines2.empty()) {
+            for (const QStringRef& l : lines1)
+                  edits.emplace_back(l, dtl::SES_DELETE);
+            for (const QStringRef& l : lines2)
+                  edits.emplace_back(l, dtl::SES_ADD);
+            return;
+            }
+      dtl::Diff<QStringRef, std::vector<QStringRef>> diff(lines1, lines2);
+      diff.compose();
+      for (const auto& ch : diff.getSes().getSequence())
+            edits.emplace_back(ch.first, ch.second.type);
+      }
+
 //---------------------------------------------------------
 //   MscxModeDiff::lineModeDiff
+//    The texts are first compared by chunks, so that equal
+//    measures are skipped by comparing their hashes. A line
+//    diff is run only on the ranges between equal chunks.
 //---------------------------------------------------------
 
 std::vector<TextDiff> MscxModeDiff::lineModeDiff(const QString& s1, const QString& s2)
       {
-      // type declarations for dtl library
-      typedef QStringRef elem;
-      typedef std::pair<elem, dtl::elemInfo> sesElem;
-      typedef std::vector<sesElem> sesElemVec;
-
       // QVector does not contain range constructor used inside dtl
       // so we have to convert to std::vector.
       std::vector<QStringRef> lines1 = s1.splitRef('\n').toStdVector();
       std::vector<QStringRef> lines2 = s2.splitRef('\n').toStdVector();
-      dtl::Diff<QStringRef, std::vector<QStringRef>> diff(lines1, lines2);
 
-      diff.compose();
+      const std::vector<Chunk> chunks1 = splitChunks(lines1);
+      const std::vector<Chunk> chunks2 = splitChunks(lines2);
+      dtl::Diff<Chunk, std::vector<Chunk>> chunkDiff(chunks1, chunks2);
+      chunkDiff.compose();
+
+      LineEdits changes;
+      changes.reserve(std::max(lines1.size(), lines2.size()));
+      std::vector<QStringRef> gap1;
+      std::vector<QStringRef> gap2;
+
+      auto flushGap = [&]() {
+            if (gap1.empty() && gap2.empty())
+                  return;
+            appendLineEdits(gap1, gap2, changes);
+            gap1.clear();
+            gap2.clear();
+            };
+
+      for (const auto& ch : chunkDiff.getSes().getSequence()) {
+            const Chunk& c = ch.first;
+            switch (ch.second.type) {
+                  case dtl::SES_COMMON:
+                        flushGap();
+                        for (int i = 0; i < c.count; ++i)
+                              changes.emplace_back((*c.lines)[c.first + i], dtl::SES_COMMON);
+                        break;
+                  case dtl::SES_DELETE:
+                        for (int i = 0; i < c.count; ++i)
+                              gap1.push_back((*c.lines)[c.first + i]);
+                        break;
+                  case dtl::SES_ADD:
+                        for (int i = 0; i < c.count; ++i)
+                              gap2.push_back((*c.lines)[c.first + i]);
+                        break;
+                  }
+            }
+      flushGap();
 
-      const sesElemVec changes = diff.getSes().getSequence();
       std::vector<TextDiff> diffs;
       int line[2][2] {{1, 1}, {1, 1}}; // for correct assigning line numbers to
                                        // DELETE and INSERT diffs we need to
                                        // count lines separately for these diff
                                        // types (EQUAL can use both counters).
 
-      for (const sesElem& ch : changes) {
-            DiffType type = fromDtlDiffType(ch.second.type);
+      for (const auto& ch : changes) {
+            DiffType type = fromDtlDiffType(ch.second);
             const int iThis = (type == DiffType::DELETE) ? 0 : 1; // for EQUAL doesn't matter
 
             if (diffs.empty() || diffs.back().type != type) {
@@ -363,47 +363,67 @@ void Selection::add(Element* el)
       }
 
 //---------------------------------------------------------
-//   canSelect
+//   filterType
+//    return the filter flag controlling the selection of
+//    elements of the given type, NONE if the element
+//    is always selectable
 //   see also `static const char* labels[]` in selectionwindow.cpp
 //---------------------------------------------------------
 
-bool SelectionFilter::canSelect(const Element* e) const
+SelectionFilterType SelectionFilter::filterType(const Element* e)
       {
-      if (e->isDynamic() || e->isHairpin())
-          return isFiltered(SelectionFilterType::DYNAMIC);
-      if (e->isArticulation() || e->isTrill() || e->isVibrato())
-          return isFiltered(SelectionFilterType::ARTICULATION);
-      if (e->type() == ElementType::LYRICS)
-          return isFiltered(SelectionFilterType::LYRICS);
-      if (e->type() == ElementType::FINGERING)
-          return isFiltered(SelectionFilterType::FINGERING);
-      if (e->type() == ElementType::HARMONY)
-          return isFiltered(SelectionFilterType::CHORD_SYMBOL);
-      if (e->type() == ElementType::SLUR)
-          return isFiltered(SelectionFilterType::SLUR);
-      if (e->type() == ElementType::FIGURED_BASS)
-          return isFiltered(SelectionFilterType::FIGURED_BASS);
-      if (e->type() == ElementType::OTTAVA)
-          return isFiltered(SelectionFilterType::OTTAVA);
-      if (e->type() == ElementType::PEDAL)
-          return isFiltered(SelectionFilterType::PEDAL_LINE);
-      if (e->type() == ElementType::ARPEGGIO)
-          return isFiltered(SelectionFilterType::ARPEGGIO);
-      if (e->type() == ElementType::GLISSANDO)
-          return isFiltered(SelectionFilterType::GLISSANDO);
-      if (e->type() == ElementType::FRET_DIAGRAM)
-          return isFiltered(SelectionFilterType::FRET_DIAGRAM);
-      if (e->type() == ElementType::BREATH)
-          return isFiltered(SelectionFilterType::BREATH);
+      switch (e->type()) {
+            case ElementType::DYNAMIC:
+            case ElementType::HAIRPIN:
+                  return SelectionFilterType::DYNAMIC;
+            case ElementType::ARTICULATION:
+            case ElementType::TRILL:
+            case ElementType::VIBRATO:
+                  return SelectionFilterType::ARTICULATION;
+            case ElementType::LYRICS:
+                  return SelectionFilterType::LYRICS;
+            case ElementType::FINGERING:
+                  return SelectionFilterType::FINGERING;
+            case ElementType::HARMONY:
+                  return SelectionFilterType::CHORD_SYMBOL;
+            case ElementType::SLUR:
+                  return SelectionFilterType::SLUR;
+            case ElementType::FIGURED_BASS:
+                  return SelectionFilterType::FIGURED_BASS;
+            case ElementType::OTTAVA:
+                  return SelectionFilterType::OTTAVA;
+            case ElementType::PEDAL:
+                  return SelectionFilterType::PEDAL_LINE;
+            case ElementType::ARPEGGIO:
+                  return SelectionFilterType::ARPEGGIO;
+            case ElementType::GLISSANDO:
+                  return SelectionFilterType::GLISSANDO;
+            case ElementType::FRET_DIAGRAM:
+                  return SelectionFilterType::FRET_DIAGRAM;
+            case ElementType::BREATH:
+                  return SelectionFilterType::BREATH;
+            case ElementType::TREMOLO:
+                  return SelectionFilterType::TREMOLO;
+            case ElementType::CHORD:
+                  return toChord(e)->isGrace() ? SelectionFilterType::GRACE_NOTE : SelectionFilterType::NONE;
+            default:
+                  break;
+            }
       if (e->isTextBase()) // only TEXT, INSTRCHANGE and STAFFTEXT are caught here, rest are system thus not in selection
-          return isFiltered(SelectionFilterType::OTHER_TEXT);
+            return SelectionFilterType::OTHER_TEXT;
       if (e->isSLine()) // NoteLine, Volta
-          return isFiltered(SelectionFilterType::OTHER_LINE);
-      if (e->isTremolo())
-          return isFiltered(SelectionFilterType::TREMOLO);
-      if (e->isChord() && toChord(e)->isGrace())
-          return isFiltered(SelectionFilterType::GRACE_NOTE);
-      return true;
+            return SelectionFilterType::OTHER_LINE;
+      return SelectionFilterType::NONE;
+      }
+
+//---------------------------------------------------------
+//   canSelect
+//---------------------------------------------------------
+
+bool SelectionFilter::canSelect(const Element* e) const
+      {
+      SelectionFilterType t = filterType(e);
+      return t == SelectionFilterType::NONE || isFiltered(t);
       }
 
 //---------------------------------------------------------
@@ -430,52 +450,58 @@ bool SelectionFilter::canSelectVoice(int track) const
 //   appendFiltered
 //---------------------------------------------------------
 
-void Selection::appendFiltered(Element* e)
+void Selection::appendFiltered(Element* e, const SelectionFilter& filter, QList<Element*>& l)
       {
-      if (selectionFilter().canSelect(e))
-            _el.append(e);
+      if (filter.canSelect(e))
+            l.append(e);
       }
 
 //---------------------------------------------------------
 //   appendChord
+//    beams collects the beams already added to the
+//    selection, a beam may be shared by chords of
+//    several tracks
 //---------------------------------------------------------
 
-void Selection::appendChord(Chord* chord)
+void Selection::appendChord(Chord* chord, const SelectionFilter& filter, QList<Element*>& l, QSet<Element*>& beams) const
       {
-      if (chord->beam() && !_el.contains(chord->beam()))
-            _el.append(chord->beam());
+      if (chord->beam() && !beams.contains(chord->beam())) {
+            beams.insert(chord->beam());
+            l.append(chord->beam());
+            }
       if (chord->stem())
-            _el.append(chord->stem());
+            l.append(chord->stem());
       if (chord->hook())
-            _el.append(chord->hook());
+            l.append(chord->hook());
       if (chord->arpeggio())
-            appendFiltered(chord->arpeggio());
+            appendFiltered(chord->arpeggio(), filter, l);
       if (chord->stemSlash())
-            _el.append(chord->stemSlash());
+            l.append(chord->stemSlash());
       if (chord->tremolo())
-            appendFiltered(chord->tremolo());
+            appendFiltered(chord->tremolo(), filter, l);
+      const Fraction etick = tickEnd();
       for (Note* note : chord->notes()) {
-            _el.append(note);
-            if (note->accidental()) _el.append(note->accidental());
-            foreach(Element* el, note->el())
-                  appendFiltered(el);
+            l.append(note);
+            if (note->accidental()) l.append(note->accidental());
+            for (Element* el : note->el())
+                  appendFiltered(el, filter, l);
             for (NoteDot* dot : note->dots())
-                  _el.append(dot);
+                  l.append(dot);
 
             if (note->tieFor() && (note->tieFor()->endElement() != 0)) {
                   if (note->tieFor()->endElement()->isNote()) {
                         Note* endNote = toNote(note->tieFor()->endElement());
                         Segment* s = endNote->chord()->segment();
-                        if (s->tick() < tickEnd())
-                              _el.append(note->tieFor());
+                        if (s->tick() < etick)
+                              l.append(note->tieFor());
                         }
                   }
             for (Spanner* sp : note->spannerFor()) {
                   if (sp->endElement()->isNote()) {
                         Note* endNote = toNote(sp->endElement());
                         Segment* s = endNote->chord()->segment();
-                        if (s->tick() < tickEnd())
-                              _el.append(sp);
+                        if (s->tick() < etick)
+                              l.append(sp);
                         }
                   }
             }
@@ -483,6 +509,10 @@ void Selection::appendChord(Chord* chord)
 
 //---------------------------------------------------------
 //   updateSelectedElements
+//    Collects the elements of a range selection in a
+//    single pass over the segments, sorting them into one
+//    list per track. The lists are concatenated afterwards
+//    so the resulting order is track by track, as before.
 //---------------------------------------------------------
 
 void Selection::updateSelectedElements()
@@ -524,48 +554,63 @@ void Selection::updateSelectedElements()
             _staffStart = 0;
             _staffEnd   = 0;
             }
-      int startTrack = _staffStart * VOICES;
-      int endTrack   = _staffEnd * VOICES;
+      const int startTrack = _staffStart * VOICES;
+      const int endTrack   = _staffEnd * VOICES;
+      const int ntracks    = endTrack - startTrack;
+
+      // evaluate the filter once instead of per element and track
+      const SelectionFilter filter = selectionFilter();
+      std::vector<bool> voiceSelectable(ntracks);
+      for (int i = 0; i < ntracks; ++i)
+            voiceSelectable[i] = filter.canSelectVoice(startTrack + i);
+
+      std::vector<QList<Element*>> trackElements(ntracks);
+      QSet<Element*> beams;
 
-      for (int st = startTrack; st < endTrack; ++st) {
-            if (!canSelectVoice(st))
+      for (Segment* s = _startSegment; s && (s != _endSegment); s = s->next1MM()) {
+            if (!s->enabled() || s->isEndBarLineType())  // do not select end bar line
                   continue;
-            for (Segment* s = _startSegment; s && (s != _endSegment); s = s->next1MM()) {
-                  if (!s->enabled() || s->isEndBarLineType())  // do not select end bar line
+            for (Element* e : s->annotations()) {
+                  int idx = e->track() - startTrack;
+                  if (idx < 0 || idx >= ntracks || !voiceSelectable[idx])
                         continue;
-                  for (Element* e : s->annotations()) {
-                        if (e->track() != st)
-                              continue;
-                        appendFiltered(e);
-                        }
-                  Element* e = s->element(st);
+                  appendFiltered(e, filter, trackElements[idx]);
+                  }
+            for (int idx = 0; idx < ntracks; ++idx) {
+                  if (!voiceSelectable[idx])
+                        continue;
+                  Element* e = s->element(startTrack + idx);
                   if (!e || e->generated() || e->isTimeSig() || e->isKeySig())
                         continue;
+                  QList<Element*>& l = trackElements[idx];
                   if (e->isChordRest()) {
                         ChordRest* cr = toChordRest(e);
                         for (Element* el : cr->lyrics()) {
                               if (el)
-                                    appendFiltered(el);
+                                    appendFiltered(el, filter, l);
                               }
                         }
                   if (e->isChord()) {
                         Chord* chord = toChord(e);
                         for (Chord* graceNote : chord->graceNotes())
-                              if (canSelect(graceNote)) appendChord(graceNote);
-                        appendChord(chord);
+                              if (filter.canSelect(graceNote)) appendChord(graceNote, filter, l, beams);
+                        appendChord(chord, filter, l, beams);
                         for (Articulation* art : chord->articulations())
-                              appendFiltered(art);
+                              appendFiltered(art, filter, l);
                         }
                   else {
-                        appendFiltered(e);
+                        appendFiltered(e, filter, l);
                         if (e->isRest()) {
                               Rest* r = toRest(e);
                               for (int i = 0; i < r->dots(); ++i)
-                                    appendFiltered(r->dot(i));
+                                    appendFiltered(r->dot(i), filter, l);
                               }
                         }
                   }
             }
+      for (const QList<Element*>& l : trackElements)
+            _el.append(l);
+
       Fraction stick = startSegment()->tick();
       Fraction etick = tickEnd();
 
@@ -574,7 +619,7 @@ void Selection::updateSelectedElements()
             // ignore spanners belonging to other tracks
             if (sp->track() < startTrack || sp->track() >= endTrack)
                   continue;
-            if (!canSelectVoice(sp->track()))
+            if (!voiceSelectable[sp->track() - startTrack])
                   continue;
             // ignore voltas
             if (sp->isVolta())
@@ -584,11 +629,11 @@ void Selection::updateSelectedElements()
                   if (!sp->startElement() || !sp->endElement())
                         continue;
                   if ((sp->tick() >= stick && sp->tick() < etick) || (sp->tick2() >= stick && sp->tick2() < etick))
-                        if (canSelect(sp->startCR()) && canSelect(sp->endCR()))
-                              appendFiltered(sp);     // slur with start or end in range selection
+                        if (filter.canSelect(sp->startCR()) && filter.canSelect(sp->endCR()))
+                              appendFiltered(sp, filter, _el);     // slur with start or end in range selection
             }
             else if ((sp->tick() >= stick && sp->tick() < etick) && (sp->tick2() >= stick && sp->tick2() <= etick))
-                  appendFiltered(sp); // spanner with start and end in range selection
+                  appendFiltered(sp, filter, _el); // spanner with start and end in range selection
             }
       update();
       }
@@ -773,6 +818,17 @@ QByteArray Selection::staffMimeData() const
       buffer.open(QIODevice::WriteOnly);
       XmlWriter xml(score(), &buffer);
       xml.header();
+      writeStaffList(xml);
+      buffer.close();
+      return buffer.buffer();
+      }
+
+//---------------------------------------------------------
+//   writeStaffList
+//---------------------------------------------------------
+
+void Selection::writeStaffList(XmlWriter& xml) const
+      {
       xml.setClipboardmode(true);
       xml.setFilter(selectionFilter());
 
@@ -815,8 +871,56 @@ QByteArray Selection::staffMimeData() const
             }
 
       xml.etag();
-      buffer.close();
-      return buffer.buffer();
+      }
+
+//---------------------------------------------------------
+//   StaffListMimeData
+//    range selection on the clipboard: the binary token
+//    form for MuseScore and the xml text, generated only
+//    when another application asks for it
+//---------------------------------------------------------
+
+class StaffListMimeData : public QMimeData {
+      XmlTokens _tokens;
+      mutable QByteArray _xml;
+
+   protected:
+      virtual QVariant retrieveData(const QString& mimeType, QVariant::Type type) const override {
+            if (mimeType == mimeStaffListFormat) {
+                  if (_xml.isEmpty())
+                        _xml = _tokens.toXml();
+                  return _xml;
+                  }
+            return QMimeData::retrieveData(mimeType, type);
+            }
+
+   public:
+      StaffListMimeData(const Selection* sel) {
+            XmlWriter xml(sel->score());
+            xml.setTokens(&_tokens);
+            sel->writeStaffList(xml);
+            setData(mimeStaffListBinaryFormat, _tokens.toByteArray());
+            }
+      virtual QStringList formats() const override {
+            return QStringList() << mimeStaffListBinaryFormat << mimeStaffListFormat;
+            }
+      virtual bool hasFormat(const QString& mimeType) const override {
+            return mimeType == mimeStaffListFormat || QMimeData::hasFormat(mimeType);
+            }
+      };
+
+//---------------------------------------------------------
+//   createMimeData
+//    clipboard content for the selection
+//---------------------------------------------------------
+
+QMimeData* Selection::createMimeData() const
+      {
+      if (_state == SelState::RANGE)
+            return new StaffListMimeData(this);
+      QMimeData* mimeData = new QMimeData;
+      mimeData->setData(mimeType(), this->mimeData());
+      return mimeData;
       }
 
 //---------------------------------------------------------
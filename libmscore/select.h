@@ -28,6 +28,7 @@ class Segment;
 class Note;
 class Measure;
 class Chord;
+class XmlWriter;
 
 //---------------------------------------------------------
 //   ElementPattern
@@ -123,6 +124,7 @@ public:
       void setFiltered(SelectionFilterType type, bool set);
       bool isFiltered(SelectionFilterType type) const        { return _filtered & (int)type; }
       bool canSelect(const Element*) const;
+      static SelectionFilterType filterType(const Element*);
       bool canSelectVoice(int track) const;
       };
 
@@ -158,8 +160,8 @@ class Selection {
       SelectionFilter selectionFilter() const;
       bool canSelect(Element* e) const { return selectionFilter().canSelect(e); }
       bool canSelectVoice(int track) const { return selectionFilter().canSelectVoice(track); }
-      void appendFiltered(Element* e);
-      void appendChord(Chord* chord);
+      static void appendFiltered(Element* e, const SelectionFilter& filter, QList<Element*>& l);
+      void appendChord(Chord* chord, const SelectionFilter& filter, QList<Element*>& l, QSet<Element*>& beams) const;
 
    public:
       Selection()                      { _score = 0; _state = SelState::NONE; }
@@ -194,6 +196,8 @@ class Selection {
       void dump();
       QString mimeType() const;
       QByteArray mimeData() const;
+      QMimeData* createMimeData() const;
+      void writeStaffList(XmlWriter&) const;
 
       Segment* startSegment() const     { return _startSegment; }
       Segment* endSegment() const       { return _endSegment;   }
@@ -1004,7 +1004,7 @@ void Spanner::setTick(const Fraction& v)
       {
       _tick = v;
       if (score())
-            score()->spannerMap().setDirty();
+            score()->spannerMap().updateSpanner(this);
       }
 
 //---------------------------------------------------------
@@ -1024,7 +1024,7 @@ void Spanner::setTicks(const Fraction& f)
       {
       _ticks = f;
       if (score())
-            score()->spannerMap().setDirty();
+            score()->spannerMap().updateSpanner(this);
       }
 
 //---------------------------------------------------------
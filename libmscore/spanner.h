@@ -14,6 +14,7 @@
 #define __SPANNER_H__
 
 #include "element.h"
+#include "mempool.h"
 
 namespace Ms {
 
@@ -56,6 +57,8 @@ class SpannerSegment : public Element {
       QPointF _offset2;
 
    public:
+      MS_POOLED_ALLOCATION
+
       SpannerSegment(Spanner*, Score*, ElementFlags f = ElementFlag::ON_STAFF | ElementFlag::MOVABLE);
       SpannerSegment(Score* s, ElementFlags f = ElementFlag::ON_STAFF | ElementFlag::MOVABLE);
       SpannerSegment(const SpannerSegment&);
@@ -15,6 +15,171 @@
 
 namespace Ms {
 
+//---------------------------------------------------------
+//   SpannerMap::Node
+//    AVL tree node ordered by start tick and insertion
+//    order, augmented with the largest stop tick of its
+//    subtree
+//---------------------------------------------------------
+
+struct SpannerMap::Node {
+      std::multimap<int, Spanner*>::iterator it;
+      int start;
+      int stop;
+      int maxStop;
+      quint64 serial;                     // insertion order, breaks ties between equal start ticks
+      int height  { 1 };
+      Node* left  { 0 };
+      Node* right { 0 };
+
+      Node(std::multimap<int, Spanner*>::iterator i, quint64 n) : it(i), serial(n) { readInterval(); }
+      Spanner* spanner() const { return it->second; }
+      void readInterval()      { start = spanner()->tick().ticks(); stop = spanner()->tick2().ticks(); }
+      };
+
+typedef SpannerMap::Node SNode;
+
+//---------------------------------------------------------
+//   interval tree helpers
+//---------------------------------------------------------
+
+static int height(const SNode* n)
+      {
+      return n ? n->height : 0;
+      }
+
+static bool nodeLess(const SNode* a, const SNode* b)
+      {
+      // nodes with the same start tick keep the order in which
+      // they were added, as the multimap does, so that queries
+      // and therefore saved files do not depend on addresses
+      return a->start < b->start || (a->start == b->start && a->serial < b->serial);
+      }
+
+static void fixNode(SNode* n)
+      {
+      n->height  = 1 + qMax(height(n->left), height(n->right));
+      n->maxStop = n->stop;
+      if (n->left)
+            n->maxStop = qMax(n->maxStop, n->left->maxStop);
+      if (n->right)
+            n->maxStop = qMax(n->maxStop, n->right->maxStop);
+      }
+
+static SNode* rotateRight(SNode* n)
+      {
+      SNode* l = n->left;
+      n->left  = l->right;
+      l->right = n;
+      fixNode(n);
+      fixNode(l);
+      return l;
+      }
+
+static SNode* rotateLeft(SNode* n)
+      {
+      SNode* r = n->right;
+      n->right = r->left;
+      r->left  = n;
+      fixNode(n);
+      fixNode(r);
+      return r;
+      }
+
+static SNode* balance(SNode* n)
+      {
+      fixNode(n);
+      int b = height(n->left) - height(n->right);
+      if (b > 1) {
+            if (height(n->left->left) < height(n->left->right))
+                  n->left = rotateLeft(n->left);
+            return rotateRight(n);
+            }
+      if (b < -1) {
+            if (height(n->right->right) < height(n->right->left))
+                  n->right = rotateRight(n->right);
+            return rotateLeft(n);
+            }
+      return n;
+      }
+
+static SNode* insertNode(SNode* n, SNode* x)
+      {
+      if (!n) {
+            x->left  = 0;
+            x->right = 0;
+            fixNode(x);
+            return x;
+            }
+      if (nodeLess(x, n))
+            n->left = insertNode(n->left, x);
+      else
+            n->right = insertNode(n->right, x);
+      return balance(n);
+      }
+
+static SNode* removeMinNode(SNode* n, SNode*& min)
+      {
+      if (!n->left) {
+            min = n;
+            return n->right;
+            }
+      n->left = removeMinNode(n->left, min);
+      return balance(n);
+      }
+
+//---------------------------------------------------------
+//   removeNode
+//    x must still have the start tick it was inserted with
+//---------------------------------------------------------
+
+static SNode* removeNode(SNode* n, SNode* x)
+      {
+      if (!n)
+            return 0;
+      if (n == x) {
+            SNode* l = n->left;
+            SNode* r = n->right;
+            if (!r)
+                  return l;
+            SNode* min = 0;
+            r = removeMinNode(r, min);
+            min->left  = l;
+            min->right = r;
+            return balance(min);
+            }
+      if (nodeLess(x, n))
+            n->left = removeNode(n->left, x);
+      else
+            n->right = removeNode(n->right, x);
+      return balance(n);
+      }
+
+static void findOverlapping(const SNode* n, int start, int stop, std::vector<Interval<Spanner*>>& results)
+      {
+      if (!n || n->maxStop < start)
+            return;
+      findOverlapping(n->left, start, stop, results);
+      if (n->start > stop)
+            return;
+      if (n->stop >= start)
+            results.push_back(Interval<Spanner*>(n->start, n->stop, n->spanner()));
+      findOverlapping(n->right, start, stop, results);
+      }
+
+static void findContained(const SNode* n, int start, int stop, std::vector<Interval<Spanner*>>& results)
+      {
+      if (!n)
+            return;
+      if (n->start >= start)
+            findContained(n->left, start, stop, results);
+      if (n->start > stop)
+            return;
+      if (n->start >= start && n->stop <= stop)
+            results.push_back(Interval<Spanner*>(n->start, n->stop, n->spanner()));
+      findContained(n->right, start, stop, results);
+      }
+
 //---------------------------------------------------------
 //   SpannerMap
 //---------------------------------------------------------
@@ -22,21 +187,32 @@ namespace Ms {
 SpannerMap::SpannerMap()
       : std::multimap<int, Spanner*>()
       {
-      dirty = true;
+      root       = 0;
+      nextSerial = 0;
+      }
+
+SpannerMap::~SpannerMap()
+      {
+      qDeleteAll(nodes);
       }
 
 //---------------------------------------------------------
 //   update
-//   updates the internal lookup tree, not the map itself
+//    the tree is kept up to date by addSpanner(),
+//    removeSpanner() and updateSpanner(); in debug builds
+//    check that no spanner changed its ticks behind
+//    its back
 //---------------------------------------------------------
 
 void SpannerMap::update() const
       {
-      std::vector< ::Interval<Spanner*> > intervals;
-      for (auto i : *this)
-            intervals.push_back(Interval<Spanner*>(i.second->tick().ticks(), i.second->tick2().ticks(), i.second));
-      tree = IntervalTree<Spanner*>(intervals);
-      dirty = false;
+#ifndef NDEBUG
+      Q_ASSERT(size_t(nodes.size()) == size());
+      for (const SNode* n : nodes) {
+            Q_ASSERT(n->start == n->spanner()->tick().ticks());
+            Q_ASSERT(n->stop == n->spanner()->tick2().ticks());
+            }
+#endif
       }
 
 //---------------------------------------------------------
@@ -45,10 +221,8 @@ void SpannerMap::update() const
 
 const std::vector<Interval<Spanner*>>& SpannerMap::findContained(int start, int stop)
       {
-      if (dirty)
-            update();
       results.clear();
-      tree.findContained(start, stop, results);
+      Ms::findContained(root, start, stop, results);
       return results;
       }
 
@@ -58,10 +232,8 @@ const std::vector<Interval<Spanner*>>& SpannerMap::findContained(int start, int
 
 const std::vector<Interval<Spanner*>>& SpannerMap::findOverlapping(int start, int stop)
       {
-      if (dirty)
-            update();
       results.clear();
-      tree.findOverlapping(start, stop, results);
+      Ms::findOverlapping(root, start, stop, results);
       return results;
       }
 
@@ -81,8 +253,9 @@ void SpannerMap::addSpanner(Spanner* s)
             }
 #endif
 #endif
-      insert(std::pair<int,Spanner*>(s->tick().ticks(), s));
-      dirty = true;
+      SNode* n = new SNode(insert(std::pair<int,Spanner*>(s->tick().ticks(), s)), nextSerial++);
+      nodes.insert(s, n);
+      root = insertNode(root, n);
       }
 
 //---------------------------------------------------------
@@ -91,15 +264,47 @@ void SpannerMap::addSpanner(Spanner* s)
 
 bool SpannerMap::removeSpanner(Spanner* s)
       {
-      for (auto i = begin(); i != end(); ++i) {
-            if (i->second == s) {
-                  erase(i);
-                  dirty = true;
-                  return true;
-                  }
+      auto i = nodes.find(s);
+      if (i == nodes.end()) {
+            qDebug("%s (%p) not found", s->name(), s);
+            return false;
+            }
+      SNode* n = i.value();
+      nodes.erase(i);
+      root = removeNode(root, n);
+      erase(n->it);
+      delete n;
+      return true;
+      }
+
+//---------------------------------------------------------
+//   updateSpanner
+//    move the spanner to its new position in the lookup
+//    tree; the key in the map is not changed
+//---------------------------------------------------------
+
+void SpannerMap::updateSpanner(Spanner* s)
+      {
+      for (auto i = nodes.find(s); i != nodes.end() && i.key() == s; ++i) {
+            SNode* n = i.value();
+            if (n->start == s->tick().ticks() && n->stop == s->tick2().ticks())
+                  continue;
+            root = removeNode(root, n);
+            n->readInterval();
+            root = insertNode(root, n);
             }
-      qDebug("%s (%p) not found", s->name(), s);
-      return false;
+      }
+
+//---------------------------------------------------------
+//   clear
+//---------------------------------------------------------
+
+void SpannerMap::clear()
+      {
+      std::multimap<int, Spanner*>::clear();
+      qDeleteAll(nodes);
+      root  = 0;
+      nodes.clear();
       }
 
 #ifndef NDEBUG
@@ -22,15 +22,27 @@ class Spanner;
 
 //---------------------------------------------------------
 //   SpannerMap
+//    spanners sorted by start tick, with an interval tree
+//    which is updated in place on add, remove and tick
+//    changes
 //---------------------------------------------------------
 
 class SpannerMap : std::multimap<int, Spanner*> {
-      mutable bool dirty;
-      mutable IntervalTree<Spanner*> tree;
+   public:
+      struct Node;                              // interval tree node, see spannermap.cpp
+
+   private:
+      Node* root;
+      QMultiHash<Spanner*, Node*> nodes;
+      quint64 nextSerial;                       // insertion order of the next node
       std::vector< ::Interval<Spanner*> > results;
 
    public:
       SpannerMap();
+      ~SpannerMap();
+      SpannerMap(const SpannerMap&) = delete;
+      SpannerMap& operator=(const SpannerMap&) = delete;
+
       const std::vector< ::Interval<Spanner*> >& findContained(int start, int stop);
       const std::vector< ::Interval<Spanner*> >& findOverlapping(int start, int stop);
       const std::multimap<int, Spanner*>& map() const { return *this; }
@@ -40,9 +52,9 @@ class SpannerMap : std::multimap<int, Spanner*> {
       std::multimap<int,Spanner*>::const_iterator cend() const  { return std::multimap<int, Spanner*>::cend(); }
       void addSpanner(Spanner* s);
       bool removeSpanner(Spanner* s);
-      void clear() { std::multimap<int, Spanner*>::clear(); dirty = true; }
-      void update() const;
-      void setDirty() const { dirty = true; }   // must be called if a spanner changes start/length
+      void updateSpanner(Spanner* s);           // must be called if a spanner changes start/length
+      void clear();
+      void update() const;                      // check the lookup tree against the spanners
 #ifndef NDEBUG
       void dump() const;
 #endif
@@ -14,6 +14,7 @@
 #define __STEM_H__
 
 #include "element.h"
+#include "mempool.h"
 
 namespace Ms {
 
@@ -31,6 +32,8 @@ class Stem final : public Element {
       qreal _len       { 0.0 };     // always positive
 
    public:
+      MS_POOLED_ALLOCATION
+
       Stem(Score* = 0);
       Stem &operator=(const Stem&) = delete;
 
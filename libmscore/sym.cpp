@@ -26,6 +26,14 @@ static FT_Library ftlib;
 namespace Ms {
 
 
+//---------------------------------------------------------
+//   fontMutex
+//    guards the lazy loading of font metrics and the
+//    FreeType faces, layout can run in several threads
+//---------------------------------------------------------
+
+static QMutex fontMutex(QMutex::Recursive);
+
 //---------------------------------------------------------
 //   scoreFonts
 //    this is the list of available score fonts
@@ -5692,6 +5700,7 @@ void ScoreFont::draw(SymId id, QPainter* painter, const QSizeF& mag, const QPoin
                   qDebug("ScoreFont::draw: invalid sym %d", int(id));
             return;
             }
+      QMutexLocker locker(&fontMutex);
       int rv = FT_Load_Glyph(face, sym(id).index(), FT_LOAD_DEFAULT);
       if (rv) {
             qDebug("load glyph id %d, failed: 0x%x", int(id), rv);
@@ -5886,11 +5895,187 @@ QString ScoreFont::toString(SymId id) const
       return codeToString(code);
       }
 
+//---------------------------------------------------------
+//   composed glyphs
+//    created from other glyphs if missing in the font
+//---------------------------------------------------------
+
+struct ComposedSym {
+      SymId id;
+      std::vector<SymId> rids;
+      };
+
+static const ComposedSym composedSyms[] = {
+      { SymId::ornamentPrallMordent,
+            {
+            SymId::ornamentZigZagLineNoRightEnd,
+            SymId::ornamentZigZagLineNoRightEnd,
+            SymId::ornamentMiddleVerticalStroke,
+            SymId::ornamentZigZagLineWithRightEnd
+            } },
+      { SymId::ornamentUpPrall,
+            {
+            SymId::ornamentBottomLeftConcaveStroke,
+            SymId::ornamentZigZagLineNoRightEnd,
+            SymId::ornamentZigZagLineNoRightEnd,
+            SymId::ornamentZigZagLineWithRightEnd
+            }},
+      { SymId::ornamentUpMordent,
+            {
+            SymId::ornamentBottomLeftConcaveStroke,
+            SymId::ornamentZigZagLineNoRightEnd,
+            SymId::ornamentZigZagLineNoRightEnd,
+            SymId::ornamentMiddleVerticalStroke,
+            SymId::ornamentZigZagLineWithRightEnd
+            }},
+      { SymId::ornamentPrallDown,
+            {
+            SymId::ornamentZigZagLineNoRightEnd,
+            SymId::ornamentZigZagLineNoRightEnd,
+            SymId::ornamentZigZagLineNoRightEnd,
+            SymId::ornamentBottomRightConcaveStroke,
+            }},
+#if 0
+      { SymId::ornamentDownPrall,
+            {
+            SymId::ornamentTopLeftConvexStroke,
+            SymId::ornamentZigZagLineNoRightEnd,
+            SymId::ornamentZigZagLineNoRightEnd,
+            SymId::ornamentZigZagLineWithRightEnd
+            }},
+#endif
+      { SymId::ornamentDownMordent,
+            {
+            SymId::ornamentLeftVerticalStroke,
+            SymId::ornamentZigZagLineNoRightEnd,
+            SymId::ornamentZigZagLineNoRightEnd,
+            SymId::ornamentMiddleVerticalStroke,
+            SymId::ornamentZigZagLineWithRightEnd
+            }},
+      { SymId::ornamentPrallUp,
+            {
+            SymId::ornamentZigZagLineNoRightEnd,
+            SymId::ornamentZigZagLineNoRightEnd,
+            SymId::ornamentZigZagLineNoRightEnd,
+            SymId::ornamentTopRightConvexStroke,
+            }},
+      { SymId::ornamentLinePrall,
+            {
+            SymId::ornamentLeftVerticalStroke,
+            SymId::ornamentZigZagLineNoRightEnd,
+            SymId::ornamentZigZagLineNoRightEnd,
+            SymId::ornamentZigZagLineWithRightEnd
+            }}
+      };
+
+//---------------------------------------------------------
+//   stylistic alternates
+//    used instead of the default glyph of the symbol
+//---------------------------------------------------------
+
+struct StylisticAlternate {
+      const char* key;
+      const char* altKey;
+      SymId       id;
+      };
+
+static const StylisticAlternate alternates[] = {
+            {     "4stringTabClef",
+                  "4stringTabClefSerif",
+                  SymId::fourStringTabClefSerif
+            },
+            {     "6stringTabClef",
+                  "6stringTabClefSerif",
+                  SymId::sixStringTabClefSerif
+            },
+            {     "cClef",
+                  "cClefFrench",
+                  SymId::cClefFrench
+            },
+            {     "cClef",
+                  "cClefFrench20C",
+                  SymId::cClefFrench20C
+            },
+            {     "fClef",
+                  "fClefFrench",
+                  SymId::fClefFrench
+            },
+            {     "fClef",
+                  "fClef19thCentury",
+                  SymId::fClef19thCentury
+            },
+            {     "noteheadBlack",
+                  "noteheadBlackOversized",
+                  SymId::noteheadBlack
+            },
+            {     "noteheadHalf",
+                  "noteheadHalfOversized",
+                  SymId::noteheadHalf
+            },
+            {     "noteheadWhole",
+                  "noteheadWholeOversized",
+                  SymId::noteheadWhole
+            },
+            {     "noteheadDoubleWhole",
+                  "noteheadDoubleWholeOversized",
+                  SymId::noteheadDoubleWhole
+            },
+            {     "noteheadDoubleWholeSquare",
+                  "noteheadDoubleWholeSquareOversized",
+                  SymId::noteheadDoubleWholeSquare
+            },
+            {     "noteheadDoubleWhole",
+                  "noteheadDoubleWholeAlt",
+                  SymId::noteheadDoubleWholeAlt
+            },
+            {     "brace",
+                  "braceSmall",
+                  SymId::braceSmall
+            },
+            {     "brace",
+                  "braceLarge",
+                  SymId::braceLarge
+            },
+            {     "brace",
+                  "braceLarger",
+                  SymId::braceLarger
+            }
+      };
+
+//---------------------------------------------------------
+//   engravingDefaultsMapping
+//---------------------------------------------------------
+
+static const std::list<std::pair<QString, Sid>> engravingDefaultsMapping = {
+      { "staffLineThickness",            Sid::staffLineWidth },
+      { "stemThickness",                 Sid::stemWidth },
+      { "beamThickness",                 Sid::beamWidth },
+      { "beamSpacing",                   Sid::beamDistance },
+      { "legerLineThickness",            Sid::ledgerLineWidth },
+      { "legerLineExtension",            Sid::ledgerLineLength },
+      { "slurEndpointThickness",         Sid::SlurEndWidth },
+      { "slurMidpointThickness",         Sid::SlurMidWidth },
+      { "thinBarlineThickness",          Sid::barWidth },
+      { "thinBarlineThickness",          Sid::doubleBarWidth },
+      { "thickBarlineThickness",         Sid::endBarWidth },
+      { "dashedBarlineThickness",        Sid::barWidth },
+      { "barlineSeparation",             Sid::doubleBarDistance },
+      { "barlineSeparation",             Sid::endBarDistance },
+      { "repeatBarlineDotSeparation",    Sid::repeatBarlineDotSeparation },
+      { "bracketThickness",              Sid::bracketWidth },
+      { "hairpinThickness",              Sid::hairpinLineWidth },
+      { "octaveLineThickness",           Sid::ottavaLineWidth },
+      { "pedalLineThickness",            Sid::pedalLineWidth },
+      { "repeatEndingLineThickness",     Sid::voltaLineWidth },
+      { "lyricLineThickness",            Sid::lyricsLineThickness },
+      { "tupletBracketThickness",        Sid::tupletBracketWidth }
+      };
+
 //---------------------------------------------------------
 //   computeMetrics
 //---------------------------------------------------------
 
-void ScoreFont::computeMetrics(Sym* sym, int code)
+void ScoreFont::computeMetrics(Sym* sym, int code) const
       {
       FT_UInt index = FT_Get_Char_Index(face, code);
       if (index != 0) {
@@ -5914,36 +6099,42 @@ void ScoreFont::computeMetrics(Sym* sym, int code)
       }
 
 //---------------------------------------------------------
-//   load
+//   readAnchors
 //---------------------------------------------------------
 
-void ScoreFont::load()
+static void readAnchors(Sym* sym, const QJsonObject& ooo)
       {
-      QString facePath = _fontPath + _filename;
-      QFile f(facePath);
-      if (!f.open(QIODevice::ReadOnly)) {
-            qDebug("ScoreFont::load(): open failed <%s>", qPrintable(facePath));
-            return;
+      constexpr qreal scale = SPATIUM20;
+      for (auto j : ooo.keys()) {
+            qreal x = ooo.value(j).toArray().at(0).toDouble();
+            qreal y = ooo.value(j).toArray().at(1).toDouble();
+            if (j == "stemDownNW")
+                  sym->setStemDownNW(QPointF(4.0 * DPI_F * x, 4.0 * DPI_F * -y));
+            else if (j == "stemUpSE")
+                  sym->setStemUpSE(QPointF(4.0 * DPI_F * x, 4.0 * DPI_F * -y));
+            else if (j == "cutOutNE")
+                  sym->setCutOutNE(QPointF(x * scale, -y * scale));
+            else if (j == "cutOutNW")
+                  sym->setCutOutNW(QPointF(x * scale, -y * scale));
+            else if (j == "cutOutSE")
+                  sym->setCutOutSE(QPointF(x * scale, -y * scale));
+            else if (j == "cutOutSW")
+                  sym->setCutOutSW(QPointF(x * scale, -y * scale));
             }
-      fontImage = f.readAll();
-      int rval = FT_New_Memory_Face(ftlib, (FT_Byte*)fontImage.data(), fontImage.size(), 0, &face);
-      if (rval) {
-            qDebug("freetype: cannot create face <%s>: %d", qPrintable(facePath), rval);
-            return;
-            }
-      cache = new QCache<GlyphKey, GlyphPixmap>(100);
+      }
 
-      qreal pixelSize = 200.0;
-      FT_Set_Pixel_Sizes(face, 0, int(pixelSize+.5));
-
-      for (size_t id = 0; id < _mainSymCodeTable.size(); ++id) {
-            uint code = _mainSymCodeTable[id];
-            if (code == 0)
-                  continue;
-            SymId symId = SymId(id);
-            Sym* sym    = &_symbols[int(symId)];
-            computeMetrics(sym, code);
-            }
+//---------------------------------------------------------
+//   loadMetadata
+//    read metadata.json on first use; the anchors are
+//    kept as json and read per symbol in resolve()
+//---------------------------------------------------------
+
+void ScoreFont::loadMetadata() const
+      {
+      QMutexLocker locker(&fontMutex);
+      if (_metadataLoaded)
+            return;
+      _metadataLoaded = true;
 
       QJsonParseError error;
       QFile fi(_fontPath + "metadata.json");
@@ -5954,76 +6145,9 @@ void ScoreFont::load()
             qDebug("Json parse error in <%s>(offset: %d): %s", qPrintable(fi.fileName()),
                error.offset, qPrintable(error.errorString()));
 
-      QJsonObject oo = metadataJson.value("glyphsWithAnchors").toObject();
-      for (auto i : oo.keys()) {
-            constexpr qreal scale = SPATIUM20;
-            QJsonObject ooo = oo.value(i).toObject();
-            SymId symId = Sym::lnhash.value(i, SymId::noSym);
-            if (symId == SymId::noSym) {
-                  // currently, Bravura contains a bunch of entries in glyphsWithAnchors
-                  // for glyph names that will not be found - flag32ndUpStraight, etc.
-                  //qDebug("ScoreFont: symId not found <%s> in <%s>", qPrintable(i), qPrintable(fi.fileName()));
-                  continue;
-                  }
-            Sym* sym = &_symbols[int(symId)];
-            for (auto j : ooo.keys()) {
-                  if (j == "stemDownNW") {
-                        qreal x = ooo.value(j).toArray().at(0).toDouble();
-                        qreal y = ooo.value(j).toArray().at(1).toDouble();
-                        sym->setStemDownNW(QPointF(4.0 * DPI_F * x, 4.0 * DPI_F * -y));
-                        }
-                  else if (j == "stemUpSE") {
-                        qreal x = ooo.value(j).toArray().at(0).toDouble();
-                        qreal y = ooo.value(j).toArray().at(1).toDouble();
-                        sym->setStemUpSE(QPointF(4.0 * DPI_F * x, 4.0 * DPI_F * -y));
-                        }
-                  else if (j == "cutOutNE") {
-                        qreal x = ooo.value(j).toArray().at(0).toDouble() * scale;
-                        qreal y = ooo.value(j).toArray().at(1).toDouble() * scale;
-                        sym->setCutOutNE(QPointF(x, -y));
-                        }
-                  else if (j == "cutOutNW") {
-                        qreal x = ooo.value(j).toArray().at(0).toDouble() * scale;
-                        qreal y = ooo.value(j).toArray().at(1).toDouble() * scale;
-                        sym->setCutOutNW(QPointF(x, -y));
-                        }
-                  else if (j == "cutOutSE") {
-                        qreal x = ooo.value(j).toArray().at(0).toDouble() * scale;
-                        qreal y = ooo.value(j).toArray().at(1).toDouble() * scale;
-                        sym->setCutOutSE(QPointF(x, -y));
-                        }
-                  else if (j == "cutOutSW") {
-                        qreal x = ooo.value(j).toArray().at(0).toDouble() * scale;
-                        qreal y = ooo.value(j).toArray().at(1).toDouble() * scale;
-                        sym->setCutOutSW(QPointF(x, -y));
-                        }
-                  }
-            }
-      oo = metadataJson.value("engravingDefaults").toObject();
-      static std::list<std::pair<QString, Sid>> engravingDefaultsMapping = {
-            { "staffLineThickness",            Sid::staffLineWidth },
-            { "stemThickness",                 Sid::stemWidth },
-            { "beamThickness",                 Sid::beamWidth },
-            { "beamSpacing",                   Sid::beamDistance },
-            { "legerLineThickness",            Sid::ledgerLineWidth },
-            { "legerLineExtension",            Sid::ledgerLineLength },
-            { "slurEndpointThickness",         Sid::SlurEndWidth },
-            { "slurMidpointThickness",         Sid::SlurMidWidth },
-            { "thinBarlineThickness",          Sid::barWidth },
-            { "thinBarlineThickness",          Sid::doubleBarWidth },
-            { "thickBarlineThickness",         Sid::endBarWidth },
-            { "dashedBarlineThickness",        Sid::barWidth },
-            { "barlineSeparation",             Sid::doubleBarDistance },
-            { "barlineSeparation",             Sid::endBarDistance },
-            { "repeatBarlineDotSeparation",    Sid::repeatBarlineDotSeparation },
-            { "bracketThickness",              Sid::bracketWidth },
-            { "hairpinThickness",              Sid::hairpinLineWidth },
-            { "octaveLineThickness",           Sid::ottavaLineWidth },
-            { "pedalLineThickness",            Sid::pedalLineWidth },
-            { "repeatEndingLineThickness",     Sid::voltaLineWidth },
-            { "lyricLineThickness",            Sid::lyricsLineThickness },
-            { "tupletBracketThickness",        Sid::tupletBracketWidth }
-            };
+      _glyphsWithAnchors = metadataJson.value("glyphsWithAnchors").toObject();
+
+      QJsonObject oo = metadataJson.value("engravingDefaults").toObject();
       for (auto i : oo.keys()) {
             for (auto mapping : engravingDefaultsMapping) {
                   if (i == mapping.first)
@@ -6034,194 +6158,92 @@ void ScoreFont::load()
             }
       _engravingDefaults.push_back(std::make_pair(Sid::MusicalTextFont, QString("%1 Text").arg(_family)));
 
-      // create missing composed glyphs
-      struct Composed {
-            SymId id;
-            std::vector<SymId> rids;
-            } composed[] = {
-
-            { SymId::ornamentPrallMordent,
-                  {
-                  SymId::ornamentZigZagLineNoRightEnd,
-                  SymId::ornamentZigZagLineNoRightEnd,
-                  SymId::ornamentMiddleVerticalStroke,
-                  SymId::ornamentZigZagLineWithRightEnd
-                  } },
-            { SymId::ornamentUpPrall,
-                  {
-                  SymId::ornamentBottomLeftConcaveStroke,
-                  SymId::ornamentZigZagLineNoRightEnd,
-                  SymId::ornamentZigZagLineNoRightEnd,
-                  SymId::ornamentZigZagLineWithRightEnd
-                  }},
-            { SymId::ornamentUpMordent,
-                  {
-                  SymId::ornamentBottomLeftConcaveStroke,
-                  SymId::ornamentZigZagLineNoRightEnd,
-                  SymId::ornamentZigZagLineNoRightEnd,
-                  SymId::ornamentMiddleVerticalStroke,
-                  SymId::ornamentZigZagLineWithRightEnd
-                  }},
-            { SymId::ornamentPrallDown,
-                  {
-                  SymId::ornamentZigZagLineNoRightEnd,
-                  SymId::ornamentZigZagLineNoRightEnd,
-                  SymId::ornamentZigZagLineNoRightEnd,
-                  SymId::ornamentBottomRightConcaveStroke,
-                  }},
-#if 0
-            { SymId::ornamentDownPrall,
-                  {
-                  SymId::ornamentTopLeftConvexStroke,
-                  SymId::ornamentZigZagLineNoRightEnd,
-                  SymId::ornamentZigZagLineNoRightEnd,
-                  SymId::ornamentZigZagLineWithRightEnd
-                  }},
-#endif
-            { SymId::ornamentDownMordent,
-                  {
-                  SymId::ornamentLeftVerticalStroke,
-                  SymId::ornamentZigZagLineNoRightEnd,
-                  SymId::ornamentZigZagLineNoRightEnd,
-                  SymId::ornamentMiddleVerticalStroke,
-                  SymId::ornamentZigZagLineWithRightEnd
-                  }},
-            { SymId::ornamentPrallUp,
-                  {
-                  SymId::ornamentZigZagLineNoRightEnd,
-                  SymId::ornamentZigZagLineNoRightEnd,
-                  SymId::ornamentZigZagLineNoRightEnd,
-                  SymId::ornamentTopRightConvexStroke,
-                  }},
-            { SymId::ornamentLinePrall,
-                  {
-                  SymId::ornamentLeftVerticalStroke,
-                  SymId::ornamentZigZagLineNoRightEnd,
-                  SymId::ornamentZigZagLineNoRightEnd,
-                  SymId::ornamentZigZagLineWithRightEnd
-                  }}
-            };
-
-      for (const Composed& c : composed) {
-            if (!_symbols[int(c.id)].isValid()) {
-                  Sym* sym = &_symbols[int(c.id)];
-                  std::vector<SymId> s;
-                  for (SymId id : c.rids)
-                        s.push_back(id);
-                  sym->setSymList(s);
-                  sym->setBbox(bbox(s, 1.0));
-                  }
-            }
-
-      // access needed stylistic alternates
-
-      struct StylisticAlternate {
-            QString     key;
-            QString     altKey;
-            SymId       id;
-            }
-      alternate[] = {
-                  {     QString("4stringTabClef"),
-                        QString("4stringTabClefSerif"),
-                        SymId::fourStringTabClefSerif
-                  },
-                  {     QString("6stringTabClef"),
-                        QString("6stringTabClefSerif"),
-                        SymId::sixStringTabClefSerif
-                  },
-                  {     QString("cClef"),
-                        QString("cClefFrench"),
-                        SymId::cClefFrench
-                  },
-                  {     QString("cClef"),
-                        QString("cClefFrench20C"),
-                        SymId::cClefFrench20C
-                  },
-                  {     QString("fClef"),
-                        QString("fClefFrench"),
-                        SymId::fClefFrench
-                  },
-                  {     QString("fClef"),
-                        QString("fClef19thCentury"),
-                        SymId::fClef19thCentury
-                  },
-                  {     QString("noteheadBlack"),
-                        QString("noteheadBlackOversized"),
-                        SymId::noteheadBlack
-                  },
-                  {     QString("noteheadHalf"),
-                        QString("noteheadHalfOversized"),
-                        SymId::noteheadHalf
-                  },
-                  {     QString("noteheadWhole"),
-                        QString("noteheadWholeOversized"),
-                        SymId::noteheadWhole
-                  },
-                  {     QString("noteheadDoubleWhole"),
-                        QString("noteheadDoubleWholeOversized"),
-                        SymId::noteheadDoubleWhole
-                  },
-                  {     QString("noteheadDoubleWholeSquare"),
-                        QString("noteheadDoubleWholeSquareOversized"),
-                        SymId::noteheadDoubleWholeSquare
-                  },
-                  {     QString("noteheadDoubleWhole"),
-                        QString("noteheadDoubleWholeAlt"),
-                        SymId::noteheadDoubleWholeAlt
-                  },
-                  {     QString("brace"),
-                        QString("braceSmall"),
-                        SymId::braceSmall
-                  },
-                  {     QString("brace"),
-                        QString("braceLarge"),
-                        SymId::braceLarge
-                  },
-                  {     QString("brace"),
-                        QString("braceLarger"),
-                        SymId::braceLarger
-                  }
-            };
-
       // find each relevant alternate in "glyphsWithAlternates" value
       QJsonObject oa = metadataJson.value("glyphsWithAlternates").toObject();
       bool ok;
-      for (const StylisticAlternate& c : alternate) {
+      for (const StylisticAlternate& c : alternates) {
             QJsonObject::const_iterator i = oa.find(c.key);
             if (i != oa.end()) {
                   QJsonArray oaa = i.value().toObject().value("alternates").toArray();
                   // locate the relevant altKey in alternate array
                   for (auto j : oaa) {
                         QJsonObject jo = j.toObject();
-                        if (jo.value("name") == c.altKey) {
-                              Sym* sym = &_symbols[int(c.id)];
+                        if (jo.value("name").toString() == c.altKey) {
                               int code = jo.value("codepoint").toString().mid(2).toInt(&ok, 16);
                               if (ok)
-                                    computeMetrics(sym, code);
+                                    _codes[int(c.id)] = code;
                               break;
                               }
                         }
                   }
             }
+      }
 
-      // add space symbol
-      Sym* sym = &_symbols[int(SymId::space)];
-      computeMetrics(sym, 32);
+//---------------------------------------------------------
+//   resolve
+//    compute metrics and anchors of a symbol on first
+//    access
+//---------------------------------------------------------
 
-#if 0
-      //
-      // check for missing symbols
-      //
-      ScoreFont* fb = ScoreFont::fallbackFont();
-      if (fb && fb != this) {
-            for (int i = 1; i < int(SymId::lastSym); ++i) {
-                  const Sym& sym = _symbols[i];
-                  if (!sym.isValid()) {
-                        qDebug("invalid symbol %s", Sym::id2name(SymId(i)));
+void ScoreFont::resolve(SymId id) const
+      {
+      QMutexLocker locker(&fontMutex);
+      const int idx = int(id);
+      if (_resolved[idx].load() || !face)
+            return;
+      loadMetadata();
+
+      Sym* sym  = &_symbols[idx];
+      uint code = _codes.value(idx, _mainSymCodeTable[idx]);
+      if (code)
+            computeMetrics(sym, code);
+      if (!sym->isValid() && code != _mainSymCodeTable[idx] && _mainSymCodeTable[idx])
+            computeMetrics(sym, _mainSymCodeTable[idx]);      // alternate glyph missing
+      auto i = _glyphsWithAnchors.constFind(Sym::id2name(id));
+      if (i != _glyphsWithAnchors.constEnd())
+            readAnchors(sym, i.value().toObject());
+      if (!sym->isValid()) {
+            for (const ComposedSym& c : composedSyms) {
+                  if (c.id == id) {
+                        sym->setSymList(c.rids);
+                        sym->setBbox(bbox(c.rids, 1.0));
+                        break;
                         }
                   }
             }
-#endif
+      _resolved[idx].storeRelease(1);
+      }
+
+//---------------------------------------------------------
+//   load
+//    only the font face is loaded here, the metrics of
+//    the symbols are computed on first access
+//---------------------------------------------------------
+
+void ScoreFont::load()
+      {
+      QMutexLocker locker(&fontMutex);
+      QString facePath = _fontPath + _filename;
+      QFile f(facePath);
+      if (!f.open(QIODevice::ReadOnly)) {
+            qDebug("ScoreFont::load(): open failed <%s>", qPrintable(facePath));
+            return;
+            }
+      fontImage = f.readAll();
+      FT_Face ftFace;
+      int rval = FT_New_Memory_Face(ftlib, (FT_Byte*)fontImage.data(), fontImage.size(), 0, &ftFace);
+      if (rval) {
+            qDebug("freetype: cannot create face <%s>: %d", qPrintable(facePath), rval);
+            return;
+            }
+      cache = new QCache<GlyphKey, GlyphPixmap>(100);
+
+      qreal pixelSize = 200.0;
+      FT_Set_Pixel_Sizes(ftFace, 0, int(pixelSize+.5));
+
+      // add space symbol
+      _codes[int(SymId::space)] = 32;
+      face = ftFace;
       }
 
 //---------------------------------------------------------
@@ -6245,8 +6267,11 @@ ScoreFont* ScoreFont::fontFactory(QString s)
             return fallbackFont();
             }
 
-      if (!f->face)
-            f->load();
+      if (!f->face) {
+            QMutexLocker locker(&fontMutex);
+            if (!f->face)
+                  f->load();
+            }
       return f;
       }
 
@@ -6257,8 +6282,11 @@ ScoreFont* ScoreFont::fontFactory(QString s)
 ScoreFont* ScoreFont::fallbackFont()
       {
       ScoreFont* f = &_scoreFonts[FALLBACK_FONT];
-      if (!f->face)
-            f->load();
+      if (!f->face) {
+            QMutexLocker locker(&fontMutex);
+            if (!f->face)
+                  f->load();
+            }
       return f;
       }
 
@@ -6400,7 +6428,8 @@ QPointF ScoreFont::cutOutSW(SymId id, qreal mag) const
 ScoreFont::ScoreFont(const ScoreFont& f)
       {
       face = 0;
-      _symbols  = f._symbols;
+      _symbols  = QVector<Sym>(f._symbols.size());     // metrics are computed on first access
+      _resolved = QVector<QAtomicInt>(f._symbols.size());
       _name     = f._name;
       _family   = f._family;
       _fontPath = f._fontPath;
@@ -2767,35 +2767,42 @@ inline uint qHash(const GlyphKey& k)
 
 class ScoreFont {
       FT_Face face = 0;
-      QVector<Sym> _symbols;
+      mutable QVector<Sym> _symbols;
+      mutable QVector<QAtomicInt> _resolved;    // metrics of the symbol are computed
+      mutable QHash<int, uint> _codes;          // code points differing from _mainSymCodeTable
+      mutable QJsonObject _glyphsWithAnchors;
+      mutable bool _metadataLoaded = false;
       QString _name;
       QString _family;
       QString _fontPath;
       QString _filename;
       QByteArray fontImage;
       QCache<GlyphKey, GlyphPixmap>* cache { 0 };
-      std::list<std::pair<Sid, QVariant>> _engravingDefaults;
-      double _textEnclosureThickness = 0;
+      mutable std::list<std::pair<Sid, QVariant>> _engravingDefaults;
+      mutable double _textEnclosureThickness = 0;
       mutable QFont* font { 0 };
 
       static QVector<ScoreFont> _scoreFonts;
       static std::array<uint, size_t(SymId::lastSym)+1> _mainSymCodeTable;
       void load();
-      void computeMetrics(Sym* sym, int code);
+      void loadMetadata() const;
+      void resolve(SymId) const;
+      void computeMetrics(Sym* sym, int code) const;
 
    public:
       ScoreFont() {}
       ScoreFont(const ScoreFont&);
       ScoreFont(const char* n, const char* f, const char* p, const char* fn)
          : _name(n), _family(f), _fontPath(p), _filename(fn) {
-            _symbols = QVector<Sym>(int(SymId::lastSym) + 1);
+            _symbols  = QVector<Sym>(int(SymId::lastSym) + 1);
+            _resolved = QVector<QAtomicInt>(int(SymId::lastSym) + 1);
             }
       ~ScoreFont();
 
       const QString& name() const           { return _name;   }
       const QString& family() const         { return _family; }
-      std::list<std::pair<Sid, QVariant>> engravingDefaults()  { return _engravingDefaults; }
-      double textEnclosureThickness() { return _textEnclosureThickness; }
+      std::list<std::pair<Sid, QVariant>> engravingDefaults()  { loadMetadata(); return _engravingDefaults; }
+      double textEnclosureThickness() { loadMetadata(); return _textEnclosureThickness; }
 
       QString fontPath() const { return _fontPath; }
 
@@ -2837,7 +2844,11 @@ class ScoreFont {
       bool isValid(SymId id) const                    { return sym(id).isValid(); }
       bool useFallbackFont(SymId id) const;
 
-      const Sym& sym(SymId id) const { return _symbols[int(id)]; }
+      const Sym& sym(SymId id) const {
+            if (!_resolved.at(int(id)).loadAcquire())
+                  resolve(id);
+            return _symbols.at(int(id));
+            }
 
       friend void initScoreFonts();
       };
@@ -19,6 +19,7 @@
 */
 
 #include "element.h"
+#include "mempool.h"
 #include "spatium.h"
 #include "symbol.h"
 #include "skyline.h"
@@ -97,6 +98,8 @@ class System final : public Element {
       Bracket* createBracket(Ms::BracketItem* bi, int column, int staffIdx, QList<Ms::Bracket *>& bl, Measure* measure);
 
 public:
+      MS_POOLED_ALLOCATION
+
       System(Score*);
       ~System();
       virtual System* clone() const override      { return new System(*this); }
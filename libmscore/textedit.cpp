@@ -53,6 +53,7 @@ void TextBase::startEdit(EditData& ed)
 
       ted->oldXmlText = xmlText();
       ted->startUndoIdx = score()->undoStack()->getCurIdx();
+      score()->undoStack()->setEvictionBarrier(ted->startUndoIdx);   // endEdit() undoes back to here
 
       if (layoutInvalid)
             layout();
@@ -75,6 +76,7 @@ void TextBase::endEdit(EditData& ed)
       UndoStack* undo = score()->undoStack();
       while (undo->getCurIdx() > ted->startUndoIdx)
             undo->undo(&ed);
+      undo->setEvictionBarrier(-1);
 
       // replace all undo/redo records collected during text editing with
       // one property change
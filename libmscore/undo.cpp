@@ -126,6 +126,54 @@ UndoCommand::~UndoCommand()
             delete c;
       }
 
+//---------------------------------------------------------
+//   variantMemoryUsage
+//    estimated heap memory held by a property value
+//---------------------------------------------------------
+
+static size_t variantMemoryUsage(const QVariant& v)
+      {
+      switch (v.type()) {
+            case QVariant::Invalid:
+                  return 0;
+            case QVariant::String:
+                  return v.toString().size() * sizeof(QChar);
+            case QVariant::ByteArray:
+                  return v.toByteArray().size();
+            case QVariant::StringList: {
+                  size_t n = 0;
+                  for (const QString& str : v.toStringList())
+                        n += sizeof(QString) + str.size() * sizeof(QChar);
+                  return n;
+                  }
+            case QVariant::List: {
+                  size_t n = 0;
+                  for (const QVariant& vv : v.toList())
+                        n += sizeof(QVariant) + variantMemoryUsage(vv);
+                  return n;
+                  }
+            default:
+                  break;
+            }
+      // values larger than the QVariant payload are stored on the heap
+      int size = QMetaType::sizeOf(v.userType());
+      return size > int(sizeof(void*)) ? size : 0;
+      }
+
+//---------------------------------------------------------
+//   UndoCommand::memoryUsage
+//    estimated number of bytes held by this command
+//    and its children
+//---------------------------------------------------------
+
+size_t UndoCommand::memoryUsage() const
+      {
+      size_t n = sizeof(UndoCommand) + childList.size() * sizeof(UndoCommand*);
+      for (auto c : childList)
+            n += c->memoryUsage();
+      return n;
+      }
+
 //---------------------------------------------------------
 //   UndoCommand::cleanup
 //---------------------------------------------------------
@@ -189,6 +237,10 @@ UndoStack::UndoStack()
       cleanState = 0;
       stateList.push_back(cleanState);
       nextState = 1;
+      evicted  = 0;
+      evictionBarrier = -1;
+      _memoryUsage = 0;
+      _memoryLimit = size_t(MScore::undoMemoryLimit) * 1024 * 1024;
       }
 
 //---------------------------------------------------------
@@ -231,15 +283,13 @@ void UndoStack::push(UndoCommand* cmd, EditData* ed)
             delete cmd;
             return;
             }
-#ifndef QT_NO_DEBUG
       if (!strcmp(cmd->name(), "ChangeProperty")) {
             ChangeProperty* cp = static_cast<ChangeProperty*>(cmd);
-            qCDebug(undoRedo, "<%s> id %d %s", cmd->name(), int(cp->getId()), propertyName(cp->getId()));
-            }
-      else {
-            qCDebug(undoRedo, "<%s>", cmd->name());
+            pushProperty(cp->getElement(), cp->getId(), cp->data(), cp->getFlags());
+            delete cmd;
+            return;
             }
-#endif
+      qCDebug(undoRedo, "<%s>", cmd->name());
       curCmd->appendChild(cmd);
       cmd->redo(ed);
       }
@@ -255,9 +305,60 @@ void UndoStack::push1(UndoCommand* cmd)
                   qWarning("no active command, UndoStack %p", this);
             return;
             }
+      if (!strcmp(cmd->name(), "ChangeProperty")) {
+            // already executed, cmd holds the old value
+            ChangeProperty* cp = static_cast<ChangeProperty*>(cmd);
+            recordProperty(cp->getElement(), cp->getId(), cp->data(), cp->getFlags());
+            delete cmd;
+            return;
+            }
       curCmd->appendChild(cmd);
       }
 
+//---------------------------------------------------------
+//   pushProperty
+//    change a property and record the old value in the
+//    property batch at the end of the current macro
+//---------------------------------------------------------
+
+void UndoStack::pushProperty(ScoreElement* e, Pid id, const QVariant& v, PropertyFlags ps)
+      {
+      QVariant ov       = e->getProperty(id);
+      PropertyFlags ops = e->propertyFlags(id);
+      e->setProperty(id, v);
+      e->setPropertyFlags(id, ps);
+      if (!curCmd) {
+            // this can happen for layout() outside of a command (load)
+            if (!ScoreLoad::loading())
+                  qDebug("no active command, UndoStack");
+            return;
+            }
+      recordProperty(e, id, ov, ops);
+      }
+
+//---------------------------------------------------------
+//   recordProperty
+//    A property changed more than once by a batch needs
+//    only the first record: it holds the value from before
+//    the command and picks up the final value when it is
+//    undone.
+//---------------------------------------------------------
+
+void UndoStack::recordProperty(ScoreElement* e, Pid id, const QVariant& ov, PropertyFlags ops)
+      {
+      qCDebug(undoRedo, "<ChangeProperty> id %d %s", int(id), propertyName(id));
+      ChangePropertyBatch* batch = 0;
+      const QList<UndoCommand*>& cl = curCmd->commands();
+      if (!cl.empty() && !strcmp(cl.back()->name(), "ChangePropertyBatch"))
+            batch = static_cast<ChangePropertyBatch*>(cl.back());
+      else {
+            batch = new ChangePropertyBatch;
+            curCmd->appendChild(batch);
+            }
+      if (!batch->contains(e, id))
+            batch->add(e, id, ov, ops);
+      }
+
 //---------------------------------------------------------
 //   remove
 //---------------------------------------------------------
@@ -270,6 +371,8 @@ void UndoStack::remove(int idx)
       while (list.size() > curIdx) {
             UndoCommand* cmd = list.takeLast();
             stateList.pop_back();
+            _memoryUsage -= usageList.back();
+            usageList.pop_back();
             cmd->cleanup(false);  // delete elements for which UndoCommand() holds ownership
             delete cmd;
 //            --curIdx;
@@ -277,6 +380,8 @@ void UndoStack::remove(int idx)
       while (list.size() > idx) {
             UndoCommand* cmd = list.takeLast();
             stateList.pop_back();
+            _memoryUsage -= usageList.back();
+            usageList.pop_back();
             cmd->cleanup(true);
             delete cmd;
             }
@@ -329,14 +434,68 @@ void UndoStack::endMacro(bool rollback)
             while (list.size() > curIdx) {
                   UndoCommand* cmd = list.takeLast();
                   stateList.pop_back();
+                  _memoryUsage -= usageList.back();
+                  usageList.pop_back();
                   cmd->cleanup(false);  // delete elements for which UndoCommand() holds ownership
                   delete cmd;
                   }
+            for (UndoCommand* cmd : curCmd->commands()) {
+                  if (!strcmp(cmd->name(), "ChangePropertyBatch"))
+                        static_cast<ChangePropertyBatch*>(cmd)->close();
+                  }
             list.append(curCmd);
             stateList.push_back(nextState++);
+            usageList.push_back(curCmd->memoryUsage());
+            _memoryUsage += usageList.back();
             ++curIdx;
             }
       curCmd = 0;
+      evict();
+      }
+
+//---------------------------------------------------------
+//   evict
+//    drop the oldest macros until the stack fits into
+//    the memory limit; the last macro is always kept
+//---------------------------------------------------------
+
+void UndoStack::evict()
+      {
+      if (!_memoryLimit || curCmd)
+            return;
+      while (_memoryUsage > _memoryLimit && curIdx > 1) {
+            if (evictionBarrier >= 0 && evicted >= evictionBarrier)
+                  break;
+            UndoCommand* cmd = list.takeFirst();
+            stateList.erase(stateList.begin());
+            _memoryUsage -= usageList.front();
+            usageList.erase(usageList.begin());
+            cmd->cleanup(true);
+            delete cmd;
+            --curIdx;
+            ++evicted;
+            }
+      }
+
+//---------------------------------------------------------
+//   setMemoryLimit
+//---------------------------------------------------------
+
+void UndoStack::setMemoryLimit(size_t bytes)
+      {
+      _memoryLimit = bytes;
+      evict();
+      }
+
+//---------------------------------------------------------
+//   dumpMemoryUsage
+//---------------------------------------------------------
+
+void UndoStack::dumpMemoryUsage() const
+      {
+      qDebug("UndoStack %p: %d macros, %d evicted, %zu bytes, limit %zu", this, list.size(), evicted, _memoryUsage, _memoryLimit);
+      for (int i = 0; i < list.size(); ++i)
+            qDebug("   %4d %s %5d commands %10zu bytes", evicted + i, i < curIdx ? "undo" : "redo", list[i]->childCount(), usageList[i]);
       }
 
 //---------------------------------------------------------
@@ -351,6 +510,8 @@ void UndoStack::reopen()
       --curIdx;
       curCmd = list.takeAt(curIdx);
       stateList.erase(stateList.begin() + curIdx);
+      _memoryUsage -= usageList[curIdx];
+      usageList.erase(usageList.begin() + curIdx);
       for (auto i : curCmd->commands()) {
             qDebug("   <%s>", i->name());
             }
@@ -375,7 +536,7 @@ void UndoStack::undo(EditData* ed)
       // Are we currently editing text?
       if (ed && ed->element && ed->element->isTextBase()) {
             TextEditData* ted = static_cast<TextEditData*>(ed->getData(ed->element));
-            if (ted && ted->startUndoIdx == curIdx)
+            if (ted && ted->startUndoIdx == getCurIdx())
                   // No edits to undo, so do nothing
                   return;
             }
@@ -401,6 +562,16 @@ void UndoStack::redo(EditData* ed)
 //   UndoMacro
 //---------------------------------------------------------
 
+size_t UndoMacro::memoryUsage() const
+      {
+      return UndoCommand::memoryUsage() + sizeof(UndoMacro) - sizeof(UndoCommand)
+         + (undoSelectionInfo.elements.capacity() + redoSelectionInfo.elements.capacity()) * sizeof(Element*);
+      }
+
+//---------------------------------------------------------
+//   fillSelectionInfo
+//---------------------------------------------------------
+
 void UndoMacro::fillSelectionInfo(SelectionInfo& info, const Selection& sel)
       {
       info.staffStart = info.staffEnd = -1;
@@ -2050,6 +2221,15 @@ void MoveStaff::flip(EditData*)
       }
 #endif
 
+//---------------------------------------------------------
+//   ChangeProperty::memoryUsage
+//---------------------------------------------------------
+
+size_t ChangeProperty::memoryUsage() const
+      {
+      return UndoCommand::memoryUsage() + sizeof(ChangeProperty) - sizeof(UndoCommand) + variantMemoryUsage(property);
+      }
+
 //---------------------------------------------------------
 //   ChangeProperty::flip
 //---------------------------------------------------------
@@ -2067,6 +2247,78 @@ void ChangeProperty::flip(EditData*)
       flags = ps;
       }
 
+//---------------------------------------------------------
+//   ChangePropertyBatch
+//---------------------------------------------------------
+
+void ChangePropertyBatch::add(ScoreElement* e, Pid id, const QVariant& v, PropertyFlags ps)
+      {
+      entries.push_back({ e, v, id, ps });
+      index.insert(qMakePair(e, int(id)));
+      }
+
+//---------------------------------------------------------
+//   close
+//    no more entries will be added
+//---------------------------------------------------------
+
+void ChangePropertyBatch::close()
+      {
+      index.clear();
+      index.squeeze();
+      entries.shrink_to_fit();
+      }
+
+//---------------------------------------------------------
+//   ChangePropertyBatch::flip
+//---------------------------------------------------------
+
+void ChangePropertyBatch::flip(Entry& entry)
+      {
+      QVariant v       = entry.element->getProperty(entry.id);
+      PropertyFlags ps = entry.element->propertyFlags(entry.id);
+
+      entry.element->setProperty(entry.id, entry.property);
+      entry.element->setPropertyFlags(entry.id, entry.flags);
+      entry.property = v;
+      entry.flags    = ps;
+      }
+
+//---------------------------------------------------------
+//   ChangePropertyBatch::undo
+//---------------------------------------------------------
+
+void ChangePropertyBatch::undo(EditData* ed)
+      {
+      for (auto i = entries.rbegin(); i != entries.rend(); ++i)
+            flip(*i);
+      UndoCommand::undo(ed);
+      }
+
+//---------------------------------------------------------
+//   ChangePropertyBatch::redo
+//---------------------------------------------------------
+
+void ChangePropertyBatch::redo(EditData* ed)
+      {
+      for (Entry& entry : entries)
+            flip(entry);
+      UndoCommand::redo(ed);
+      }
+
+//---------------------------------------------------------
+//   ChangePropertyBatch::memoryUsage
+//---------------------------------------------------------
+
+size_t ChangePropertyBatch::memoryUsage() const
+      {
+      size_t n = UndoCommand::memoryUsage() + sizeof(ChangePropertyBatch) - sizeof(UndoCommand)
+         + entries.capacity() * sizeof(Entry) + index.capacity() * (sizeof(QPair<ScoreElement*, int>) + sizeof(void*));
+      for (const Entry& entry : entries)
+            n += variantMemoryUsage(entry.property);
+      return n;
+      }
+
 //---------------------------------------------------------
 //   ChangeBracketProperty::flip
 //---------------------------------------------------------
@@ -2249,6 +2501,7 @@ void ChangeNoteEvent::flip(EditData*)
 LinkUnlink::~LinkUnlink()
       {
       if (le && mustDelete) {
+            QMutexLocker locker(&linkMutex);
             Q_ASSERT(le->size() <= 1);
             delete le;
             }
@@ -2256,17 +2509,19 @@ LinkUnlink::~LinkUnlink()
 
 void LinkUnlink::link()
       {
+      QMutexLocker locker(&linkMutex);
       if (le->size() == 1)
             le->front()->setLinks(le);
       mustDelete = false;
-      le->append(e);
+      le->addLink(e);
       e->setLinks(le);
       }
 
 void LinkUnlink::unlink()
       {
+      QMutexLocker locker(&linkMutex);
       Q_ASSERT(le->contains(e));
-      le->removeOne(e);
+      le->removeLink(e);
       if (le->size() == 1) {
             le->front()->setLinks(0);
             mustDelete = true;
@@ -2283,13 +2538,17 @@ void LinkUnlink::unlink()
 Link::Link(ScoreElement* e1, ScoreElement* e2)
       {
       Q_ASSERT(e1->links() == 0);
+      QMutexLocker locker(&linkMutex);
       le = e2->links();
       if (!le) {
             if (e1->isStaff())
                   le = new LinkedElements(e1->score(), -1);
             else
                   le = new LinkedElements(e1->score());
-            le->push_back(e2);
+            le->addLink(e2);
+            // attach the list right away, another thread may
+            // link to e2 before this command is executed
+            e2->setLinks(le);
             }
       e = e1;
       }
@@ -109,6 +109,7 @@ class UndoCommand {
       void unwind();
       const QList<UndoCommand*>& commands() const { return childList; }
       virtual void cleanup(bool undo);
+      virtual size_t memoryUsage() const;
 // #ifndef QT_NO_DEBUG
       virtual const char* name() const { return "UndoCommand"; }
 // #endif
@@ -146,6 +147,7 @@ class UndoMacro : public UndoCommand {
       virtual void undo(EditData*) override;
       virtual void redo(EditData*) override;
       bool empty() const { return childCount() == 0; }
+      virtual size_t memoryUsage() const override;
       UNDO_NAME("UndoMacro");
       };
 
@@ -157,11 +159,18 @@ class UndoStack {
       UndoMacro* curCmd;
       QList<UndoMacro*> list;
       std::vector<int> stateList;
+      std::vector<size_t> usageList;      // estimated size of the macros in list
       int nextState;
       int cleanState;
       int curIdx;
+      int evicted;                        // number of macros dropped from the bottom of the stack
+      int evictionBarrier;                // do not evict macros at or above this index
+      size_t _memoryUsage;
+      size_t _memoryLimit;                // in bytes, 0: unlimited
 
       void remove(int idx);
+      void evict();
+      void recordProperty(ScoreElement*, Pid, const QVariant&, PropertyFlags);
 
    public:
       UndoStack();
@@ -172,13 +181,14 @@ class UndoStack {
       void endMacro(bool rollback);
       void push(UndoCommand*, EditData*);      // push & execute
       void push1(UndoCommand*);
+      void pushProperty(ScoreElement*, Pid, const QVariant&, PropertyFlags);   // change & record
       void pop();
       void setClean();
       bool canUndo() const          { return curIdx > 0;           }
       bool canRedo() const          { return curIdx < list.size(); }
       int state() const             { return stateList[curIdx];    }
       bool isClean() const          { return cleanState == state();     }
-      int getCurIdx() const         { return curIdx; }
+      int getCurIdx() const         { return evicted + curIdx; }
       bool empty() const            { return !canUndo() && !canRedo();  }
       UndoMacro* current() const    { return curCmd;               }
       UndoMacro* last() const       { return curIdx > 0 ? list[curIdx-1] : 0; }
@@ -186,6 +196,14 @@ class UndoStack {
       void redo(EditData*);
       void rollback();
       void reopen();
+
+      void setMemoryLimit(size_t bytes);
+      size_t memoryLimit() const    { return _memoryLimit; }
+      size_t memoryUsage() const    { return _memoryUsage; }
+      int count() const             { return list.size();  }
+      int evictedCount() const      { return evicted;      }
+      void setEvictionBarrier(int idx) { evictionBarrier = idx; }
+      void dumpMemoryUsage() const;
       };
 
 //---------------------------------------------------------
@@ -996,9 +1014,40 @@ class ChangeProperty : public UndoCommand {
       Pid getId() const  { return id; }
       ScoreElement* getElement() const { return element; }
       QVariant data() const { return property; }
+      PropertyFlags getFlags() const { return flags; }
+      virtual size_t memoryUsage() const override;
       UNDO_NAME("ChangeProperty")
       };
 
+//---------------------------------------------------------
+//   ChangePropertyBatch
+//    consecutive property changes of a command stored
+//    in one array, built by UndoStack::pushProperty()
+//---------------------------------------------------------
+
+class ChangePropertyBatch : public UndoCommand {
+      struct Entry {
+            ScoreElement* element;
+            QVariant property;
+            Pid id;
+            PropertyFlags flags;
+            };
+      std::vector<Entry> entries;
+      QSet<QPair<ScoreElement*, int>> index;    // (element, pid) of entries, cleared by close()
+
+      static void flip(Entry&);
+
+   public:
+      bool contains(ScoreElement* e, Pid id) const { return index.contains(qMakePair(e, int(id))); }
+      void add(ScoreElement*, Pid, const QVariant&, PropertyFlags);
+      void close();
+      int size() const { return int(entries.size()); }
+      virtual void undo(EditData*) override;
+      virtual void redo(EditData*) override;
+      virtual size_t memoryUsage() const override;
+      UNDO_NAME("ChangePropertyBatch")
+      };
+
 //---------------------------------------------------------
 //   ChangeBracketProperty
 //---------------------------------------------------------
@@ -114,24 +114,25 @@ static void removeRepeatMarkings(Score* score)
 static void createExcerpts(MasterScore* cs, QList<Excerpt *> excerpts)
       {
       // borrowed from musescore.cpp endsWith(".pdf")
+      cs->startCmd();
       for (Excerpt* e: excerpts) {
             Score* nscore = new Score(e->oscore());
             e->setPartScore(nscore);
             nscore->style().set(Sid::createMultiMeasureRests, true);
-            cs->startCmd();
             cs->undo(new AddExcerpt(e));
-            Excerpt::createExcerpt(e);
+            }
+      Excerpt::createExcerpts(excerpts);
 
+      for (Excerpt* e: excerpts) {
             // borrowed from excerptsdialog.cpp
             // a new excerpt is created in AddExcerpt, make sure the parts are filed
             for (Excerpt* ee : e->oscore()->excerpts())
-                  if (ee->partScore() == nscore && ee != e) {
+                  if (ee->partScore() == e->partScore() && ee != e) {
                         ee->parts().clear();
                         ee->parts().append(e->parts());
                         }
-
-            cs->endCmd();
             }
+      cs->endCmd();
       }
 
 //---------------------------------------------------------
@@ -42,6 +42,9 @@ QRectF handleRect(const QPointF& pos)
 
 //---------------------------------------------------------
 //   tick2measure
+//    binary search in the measure index; if the measures
+//    found do not enclose tick, as while an edit has left
+//    the ticks out of order, all measures are scanned
 //---------------------------------------------------------
 
 Measure* Score::tick2measure(const Fraction& tick) const
@@ -51,6 +54,14 @@ Measure* Score::tick2measure(const Fraction& tick) const
       if (tick <= Fraction(0,1))
             return firstMeasure();
 
+      const std::vector<Measure*>& ml = _measures.measureIndex();
+      auto i = std::upper_bound(ml.begin(), ml.end(), tick, [](const Fraction& t, const Measure* m) { return t < m->tick(); });
+      if (i != ml.begin() && (*(i - 1))->tick() <= tick && (i == ml.end() || tick < (*i)->tick())) {
+            Measure* m = *(i - 1);
+            if (i != ml.end() || tick <= m->endTick())
+                  return m;
+            }
+
       Measure* lm = 0;
       for (Measure* m = firstMeasure(); m; m = m->nextMeasure()) {
             if (tick < m->tick()) {
@@ -66,6 +77,35 @@ Measure* Score::tick2measure(const Fraction& tick) const
       return 0;
       }
 
+//---------------------------------------------------------
+//   correspondingMeasure
+//    the measure of this score at the position m has in
+//    its own score, i.e. its counterpart in a linked score
+//---------------------------------------------------------
+
+Measure* Score::correspondingMeasure(const Measure* m) const
+      {
+      const std::vector<Measure*>& sl = m->score()->measures()->measureIndex();
+      int idx = m->listIndex();
+      if (idx >= 0 && idx < int(sl.size()) && sl[idx] == m) {
+            const std::vector<Measure*>& ml = _measures.measureIndex();
+            if (idx < int(ml.size()) && ml[idx]->tick() == m->tick())
+                  return ml[idx];
+            }
+      // not in the measure list (mm rest) or the lists differ
+      return tick2measure(m->tick());
+      }
+
+//---------------------------------------------------------
+//   correspondingSegment
+//---------------------------------------------------------
+
+Segment* Score::correspondingSegment(const Segment* s) const
+      {
+      Measure* m = correspondingMeasure(s->measure());
+      return m ? m->findSegment(s->segmentType(), s->tick()) : 0;
+      }
+
 //---------------------------------------------------------
 //   tick2measureMM
 //---------------------------------------------------------
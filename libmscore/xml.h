@@ -60,6 +60,50 @@ class LinksIndexer {
       int assignLocalIndex(const Location& mainElementInfo);
       };
 
+//---------------------------------------------------------
+//   XmlTokens
+//    Compact binary form of an xml document, used as internal
+//    clipboard format. Every name, attribute value and text
+//    is stored once in a string table; the document is a list
+//    of tokens referring to it:
+//      START: (name << 2) | 0, attribute count, (name, value)...
+//      END:   1
+//      TEXT:  (text << 2) | 2
+//    Whitespace between elements is kept as a TEXT token with
+//    string 0 so that the token sequence seen by XmlReader
+//    matches the one of the xml text.
+//---------------------------------------------------------
+
+class XmlTokens {
+      QVector<QString> _strings;
+      QHash<QString, quint32> _index;     // only used while writing
+      std::vector<quint32> _tokens;
+
+      quint32 intern(const QString&);
+      void addAttributes(const QString&, int from);
+
+   public:
+      enum : quint32 { START = 0, END = 1, TEXT = 2, WHITESPACE = (0 << 2) | TEXT };
+
+      XmlTokens();
+
+      void startElement(const QString& tag);
+      void startElement(const QString& name, const QString& attributes);
+      void endElement()                   { _tokens.push_back(END); }
+      void text(const QString&);
+      void whitespace()                   { _tokens.push_back(WHITESPACE); }
+      void xmlFragment(const QString&);
+
+      const QVector<QString>& strings() const     { return _strings; }
+      const std::vector<quint32>& tokens() const  { return _tokens;  }
+
+      QByteArray toByteArray() const;
+      bool fromByteArray(const QByteArray&);
+      QByteArray toXml() const;
+
+      static QString unescape(const QString&);
+      };
+
 //---------------------------------------------------------
 //   XmlReader
 //---------------------------------------------------------
@@ -104,8 +148,23 @@ class XmlReader : public QXmlStreamReader {
       void addConnectorInfo(std::unique_ptr<ConnectorInfoReader>);
       void removeConnector(const ConnectorInfoReader*); // Removes the whole ConnectorInfo chain from the connectors list.
 
+      // reading from XmlTokens instead of xml text
+      const XmlTokens* _binary      { nullptr };
+      size_t _binaryPos             { 0 };
+      TokenType _binaryToken        { NoToken };
+      const QString* _binaryName    { nullptr };
+      const QString* _binaryText    { nullptr };
+      QXmlStreamAttributes _binaryAttributes;
+      std::vector<const QString*> _binaryStack;
+
+      TokenType readNextBinary();
+      bool readNextStartElementBinary();
+      void skipCurrentElementBinary();
+      QString readElementTextBinary(ReadElementTextBehaviour);
+
    public:
       XmlReader(QFile* f) : QXmlStreamReader(f), docName(f->fileName()) {}
+      XmlReader(const XmlTokens* t, const QString& st = QString()) : QXmlStreamReader(), docName(st), _binary(t) {}
       XmlReader(const QByteArray& d, const QString& st = QString()) : QXmlStreamReader(d), docName(st)  {}
       XmlReader(QIODevice* d, const QString& st = QString()) : QXmlStreamReader(d), docName(st) {}
       XmlReader(const QString& d, const QString& st = QString()) : QXmlStreamReader(d), docName(st) {}
@@ -116,6 +175,26 @@ class XmlReader : public QXmlStreamReader {
       bool hasAccidental;                     // used for userAccidental backward compatibility
       void unknown();
 
+      // QXmlStreamReader interface, redirected when reading XmlTokens
+      TokenType readNext()                { return _binary ? readNextBinary() : QXmlStreamReader::readNext(); }
+      bool readNextStartElement()         { return _binary ? readNextStartElementBinary() : QXmlStreamReader::readNextStartElement(); }
+      void skipCurrentElement()           { if (_binary) skipCurrentElementBinary(); else QXmlStreamReader::skipCurrentElement(); }
+      QString readElementText(ReadElementTextBehaviour b = ErrorOnUnexpectedElement) {
+            return _binary ? readElementTextBinary(b) : QXmlStreamReader::readElementText(b);
+            }
+      TokenType tokenType() const         { return _binary ? _binaryToken : QXmlStreamReader::tokenType(); }
+      QStringRef name() const             { return _binary ? QStringRef(_binaryName) : QXmlStreamReader::name(); }
+      QStringRef text() const             { return _binary ? QStringRef(_binaryText) : QXmlStreamReader::text(); }
+      QXmlStreamAttributes attributes() const { return _binary ? _binaryAttributes : QXmlStreamReader::attributes(); }
+      bool isStartElement() const         { return tokenType() == StartElement; }
+      bool isEndElement() const           { return tokenType() == EndElement;   }
+      bool isCharacters() const           { return tokenType() == Characters;   }
+      bool isWhitespace() const;
+      bool atEnd() const;
+      QString tokenString() const;
+      qint64 lineNumber() const           { return _binary ? qint64(_binaryPos) : QXmlStreamReader::lineNumber(); }
+      qint64 columnNumber() const         { return _binary ? 0 : QXmlStreamReader::columnNumber(); }
+
       // attribute helper routines:
       QString attribute(const char* s) const { return attributes().value(s).toString(); }
       QString attribute(const char* s, const QString&) const;
@@ -239,7 +318,10 @@ class XmlWriter : public QTextStream {
       std::vector<std::pair<const ScoreElement*, QString>> _elements;
       bool _recordElements = false;
 
+      XmlTokens* _tokens { nullptr };     // binary output instead of text
+
       void putLevel();
+      void tokensTag(const QString& name, const QVariant& data);
 
    public:
       XmlWriter(Score*);
@@ -277,6 +359,9 @@ class XmlWriter : public QTextStream {
       const std::vector<std::pair<const ScoreElement*, QString>>& elements() const { return _elements; }
       void setRecordElements(bool record) { _recordElements = record; }
 
+      void setTokens(XmlTokens* t)        { _tokens = t;    }
+      XmlTokens* tokens() const           { return _tokens; }
+
       void sTag(const char* name, Spatium sp) { XmlWriter::tag(name, QVariant(sp.val())); }
       void pTag(const char* name, PlaceText);
 
@@ -757,6 +757,164 @@ void XmlReader::incTick(const Fraction& f)
       _tick.reduce();
       _intTick += f.ticks();
       }
+//---------------------------------------------------------
+//   readNextBinary
+//    token stream of XmlTokens; reports the same token
+//    types as QXmlStreamReader does for the xml text
+//---------------------------------------------------------
+
+QXmlStreamReader::TokenType XmlReader::readNextBinary()
+      {
+      _binaryAttributes.clear();
+      _binaryText = nullptr;
+      if (QXmlStreamReader::hasError())
+            return _binaryToken = Invalid;
+      if (_binaryToken == NoToken)
+            return _binaryToken = StartDocument;
+      const std::vector<quint32>& tokens = _binary->tokens();
+      if (_binaryPos >= tokens.size()) {
+            if (_binaryToken == EndDocument || _binaryToken == Invalid)
+                  return _binaryToken = Invalid;
+            _binaryName = nullptr;
+            return _binaryToken = EndDocument;
+            }
+      const QVector<QString>& strings = _binary->strings();
+      quint32 t = tokens[_binaryPos++];
+      switch (t & 3) {
+            case XmlTokens::START: {
+                  _binaryName = &strings[t >> 2];
+                  _binaryStack.push_back(_binaryName);
+                  quint32 n = tokens[_binaryPos++];
+                  for (quint32 i = 0; i < n; ++i) {
+                        _binaryAttributes.append(strings[tokens[_binaryPos]], strings[tokens[_binaryPos + 1]]);
+                        _binaryPos += 2;
+                        }
+                  return _binaryToken = StartElement;
+                  }
+            case XmlTokens::END:
+                  _binaryName = _binaryStack.back();
+                  _binaryStack.pop_back();
+                  return _binaryToken = EndElement;
+            default:
+                  _binaryText = &strings[t >> 2];
+                  return _binaryToken = Characters;
+            }
+      }
+
+//---------------------------------------------------------
+//   readNextStartElementBinary
+//---------------------------------------------------------
+
+bool XmlReader::readNextStartElementBinary()
+      {
+      while (readNextBinary() != Invalid) {
+            if (_binaryToken == EndElement || _binaryToken == EndDocument)
+                  return false;
+            if (_binaryToken == StartElement)
+                  return true;
+            }
+      return false;
+      }
+
+//---------------------------------------------------------
+//   skipCurrentElementBinary
+//---------------------------------------------------------
+
+void XmlReader::skipCurrentElementBinary()
+      {
+      int depth = 1;
+      while (depth && readNextBinary() != Invalid) {
+            if (_binaryToken == EndElement)
+                  --depth;
+            else if (_binaryToken == StartElement)
+                  ++depth;
+            }
+      }
+
+//---------------------------------------------------------
+//   readElementTextBinary
+//---------------------------------------------------------
+
+QString XmlReader::readElementTextBinary(ReadElementTextBehaviour behaviour)
+      {
+      if (_binaryToken != StartElement)
+            return QString();
+      QString result;
+      for (;;) {
+            switch (readNextBinary()) {
+                  case Characters:
+                        result += *_binaryText;
+                        break;
+                  case EndElement:
+                        return result;
+                  case StartElement:
+                        if (behaviour == SkipChildElements) {
+                              skipCurrentElementBinary();
+                              break;
+                              }
+                        if (behaviour == IncludeChildElements) {
+                              result += readElementTextBinary(behaviour);
+                              break;
+                              }
+                        raiseError(QObject::tr("Expected character data."));
+                        return result;
+                  default:
+                        if (!QXmlStreamReader::hasError())
+                              raiseError(QObject::tr("Expected character data."));
+                        return result;
+                  }
+            }
+      }
+
+//---------------------------------------------------------
+//   isWhitespace
+//---------------------------------------------------------
+
+bool XmlReader::isWhitespace() const
+      {
+      if (!_binary)
+            return QXmlStreamReader::isWhitespace();
+      if (_binaryToken != Characters)
+            return false;
+      if (_binaryText == &_binary->strings()[0])
+            return true;
+      for (const QChar& c : *_binaryText) {
+            if (!c.isSpace())
+                  return false;
+            }
+      return true;
+      }
+
+//---------------------------------------------------------
+//   atEnd
+//---------------------------------------------------------
+
+bool XmlReader::atEnd() const
+      {
+      if (!_binary)
+            return QXmlStreamReader::atEnd();
+      return _binaryToken == EndDocument || _binaryToken == Invalid || QXmlStreamReader::hasError();
+      }
+
+//---------------------------------------------------------
+//   tokenString
+//---------------------------------------------------------
+
+QString XmlReader::tokenString() const
+      {
+      if (!_binary)
+            return QXmlStreamReader::tokenString();
+      switch (_binaryToken) {
+            case StartDocument: return QLatin1String("StartDocument");
+            case EndDocument:   return QLatin1String("EndDocument");
+            case StartElement:  return QLatin1String("StartElement");
+            case EndElement:    return QLatin1String("EndElement");
+            case Characters:    return QLatin1String("Characters");
+            case Invalid:       return QLatin1String("Invalid");
+            default:            return QLatin1String("NoToken");
+            }
+      }
+
 }
 
 
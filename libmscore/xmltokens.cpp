@@ -0,0 +1,374 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2019 Werner Schweer and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#include "xml.h"
+
+namespace Ms {
+
+static const quint32 TOKENS_MAGIC   = 0x4d535442;    // "MSTB"
+static const quint32 TOKENS_VERSION = 1;
+static const int MAX_DEPTH          = 256;
+
+//---------------------------------------------------------
+//   XmlTokens
+//    string 0 is reserved for the whitespace between
+//    elements, it is not entered into the index so that
+//    real text never maps to it
+//---------------------------------------------------------
+
+XmlTokens::XmlTokens()
+      {
+      _strings.append(QString("\n"));
+      }
+
+//---------------------------------------------------------
+//   intern
+//---------------------------------------------------------
+
+quint32 XmlTokens::intern(const QString& s)
+      {
+      auto i = _index.constFind(s);
+      if (i != _index.constEnd())
+            return i.value();
+      quint32 idx = _strings.size();
+      _strings.append(s);
+      _index.insert(s, idx);
+      return idx;
+      }
+
+//---------------------------------------------------------
+//   unescape
+//    resolve the entities written by XmlWriter::xmlString()
+//    and character references
+//---------------------------------------------------------
+
+QString XmlTokens::unescape(const QString& s)
+      {
+      int amp = s.indexOf('&');
+      if (amp == -1)
+            return s;
+      QString r = s.left(amp);
+      for (int i = amp; i < s.size(); ++i) {
+            QChar c = s.at(i);
+            if (c != '&') {
+                  r += c;
+                  continue;
+                  }
+            int end = s.indexOf(';', i);
+            if (end == -1) {
+                  r += s.midRef(i);
+                  break;
+                  }
+            QStringRef ent = s.midRef(i + 1, end - i - 1);
+            if (ent == "lt")
+                  r += '<';
+            else if (ent == "gt")
+                  r += '>';
+            else if (ent == "amp")
+                  r += '&';
+            else if (ent == "quot")
+                  r += '"';
+            else if (ent == "apos")
+                  r += '\'';
+            else if (ent.startsWith('#')) {
+                  bool ok;
+                  uint code = ent.startsWith("#x") ? ent.mid(2).toUInt(&ok, 16) : ent.mid(1).toUInt(&ok, 10);
+                  if (!ok) {
+                        r += s.midRef(i, end - i + 1);
+                        i = end;
+                        continue;
+                        }
+                  if (QChar::requiresSurrogates(code)) {
+                        r += QChar(QChar::highSurrogate(code));
+                        r += QChar(QChar::lowSurrogate(code));
+                        }
+                  else
+                        r += QChar(code);
+                  }
+            else
+                  r += s.midRef(i, end - i + 1);
+            i = end;
+            }
+      return r;
+      }
+
+//---------------------------------------------------------
+//   addAttributes
+//    parse name="value" pairs of s starting at from
+//---------------------------------------------------------
+
+void XmlTokens::addAttributes(const QString& s, int from)
+      {
+      size_t countIdx = _tokens.size();
+      _tokens.push_back(0);
+      quint32 n = 0;
+      int i = from;
+      const int len = s.size();
+      for (;;) {
+            while (i < len && s.at(i).isSpace())
+                  ++i;
+            int eq = s.indexOf('=', i);
+            if (i >= len || eq == -1 || eq + 1 >= len)
+                  break;
+            QChar quote = s.at(eq + 1);
+            int end = s.indexOf(quote, eq + 2);
+            if (end == -1)
+                  break;
+            _tokens.push_back(intern(s.mid(i, eq - i).trimmed()));
+            _tokens.push_back(intern(unescape(s.mid(eq + 2, end - eq - 2))));
+            ++n;
+            i = end + 1;
+            }
+      _tokens[countIdx] = n;
+      }
+
+//---------------------------------------------------------
+//   startElement
+//    tag is "name" or "name attribute="value" ..." as
+//    passed to XmlWriter::stag()
+//---------------------------------------------------------
+
+void XmlTokens::startElement(const QString& tag)
+      {
+      int space = tag.indexOf(' ');
+      if (space == -1) {
+            _tokens.push_back((intern(tag) << 2) | START);
+            _tokens.push_back(0);
+            return;
+            }
+      _tokens.push_back((intern(tag.left(space)) << 2) | START);
+      addAttributes(tag, space + 1);
+      }
+
+void XmlTokens::startElement(const QString& name, const QString& attributes)
+      {
+      _tokens.push_back((intern(name) << 2) | START);
+      if (attributes.isEmpty())
+            _tokens.push_back(0);
+      else
+            addAttributes(attributes, 0);
+      }
+
+//---------------------------------------------------------
+//   text
+//---------------------------------------------------------
+
+void XmlTokens::text(const QString& s)
+      {
+      if (!s.isEmpty())
+            _tokens.push_back((intern(s) << 2) | TEXT);
+      }
+
+//---------------------------------------------------------
+//   xmlFragment
+//    add already escaped markup as written by
+//    XmlWriter::writeXml(), e.g. "a <b>bold</b> &amp; b"
+//---------------------------------------------------------
+
+void XmlTokens::xmlFragment(const QString& s)
+      {
+      const int len = s.size();
+      int i = 0;
+      int depth = 0;
+      while (i < len) {
+            if (s.at(i) != '<') {
+                  int end = s.indexOf('<', i);
+                  if (end == -1)
+                        end = len;
+                  text(unescape(s.mid(i, end - i)));
+                  i = end;
+                  continue;
+                  }
+            // find the end of the tag, skipping quoted attribute values
+            int end = i + 1;
+            QChar quote;
+            for (; end < len; ++end) {
+                  QChar c = s.at(end);
+                  if (!quote.isNull()) {
+                        if (c == quote)
+                              quote = QChar();
+                        }
+                  else if (c == '"' || c == '\'')
+                        quote = c;
+                  else if (c == '>')
+                        break;
+                  }
+            if (end >= len) {
+                  text(unescape(s.mid(i)));
+                  break;
+                  }
+            QString tag = s.mid(i + 1, end - i - 1).trimmed();
+            if (tag.startsWith('/')) {
+                  if (depth > 0) {
+                        endElement();
+                        --depth;
+                        }
+                  }
+            else if (tag.endsWith('/')) {
+                  tag.chop(1);
+                  startElement(tag.trimmed());
+                  endElement();
+                  }
+            else if (!tag.startsWith('!') && !tag.startsWith('?')) {
+                  startElement(tag);
+                  ++depth;
+                  }
+            i = end + 1;
+            }
+      // keep the token stream balanced for malformed input
+      while (depth-- > 0)
+            endElement();
+      }
+
+//---------------------------------------------------------
+//   toByteArray
+//---------------------------------------------------------
+
+QByteArray XmlTokens::toByteArray() const
+      {
+      QByteArray data;
+      QDataStream ds(&data, QIODevice::WriteOnly);
+      ds << TOKENS_MAGIC << TOKENS_VERSION << _strings << quint32(_tokens.size());
+      for (quint32 t : _tokens)
+            ds << t;
+      return data;
+      }
+
+//---------------------------------------------------------
+//   fromByteArray
+//    returns false if data is not a well formed token
+//    stream; indices and nesting are checked here so
+//    that XmlReader can trust the tokens
+//---------------------------------------------------------
+
+bool XmlTokens::fromByteArray(const QByteArray& data)
+      {
+      _strings.clear();
+      _index.clear();
+      _tokens.clear();
+
+      QDataStream ds(data);
+      quint32 magic, version, n;
+      ds >> magic >> version;
+      if (ds.status() != QDataStream::Ok || magic != TOKENS_MAGIC || version != TOKENS_VERSION)
+            return false;
+      // read the string count before allocating anything, each
+      // string takes at least its four byte length in data
+      quint32 nStrings;
+      ds >> nStrings;
+      if (ds.status() != QDataStream::Ok || nStrings == 0 || nStrings > quint32(data.size() / 4))
+            return false;
+      _strings.resize(nStrings);
+      for (QString& s : _strings)
+            ds >> s;
+      ds >> n;
+      if (ds.status() != QDataStream::Ok || n > quint32(data.size() / 4))
+            return false;
+      _tokens.resize(n);
+      for (quint32& t : _tokens)
+            ds >> t;
+      if (ds.status() != QDataStream::Ok)
+            return false;
+
+      int depth = 0;
+      for (size_t i = 0; i < _tokens.size(); ++i) {
+            quint32 t = _tokens[i];
+            switch (t & 3) {
+                  case START: {
+                        if ((t >> 2) >= nStrings || i + 1 >= _tokens.size() || ++depth > MAX_DEPTH)
+                              return false;
+                        quint32 nAttr = _tokens[++i];
+                        if (nAttr > (_tokens.size() - i - 1) / 2)
+                              return false;
+                        for (quint32 k = 0; k < nAttr * 2; ++k) {
+                              if (_tokens[++i] >= nStrings)
+                                    return false;
+                              }
+                        }
+                        break;
+                  case END:
+                        if (t != END || --depth < 0)
+                              return false;
+                        break;
+                  case TEXT:
+                        if ((t >> 2) >= nStrings)
+                              return false;
+                        break;
+                  default:
+                        return false;
+                  }
+            }
+      return depth == 0;
+      }
+
+//---------------------------------------------------------
+//   toXml
+//    regenerate the xml text, used as fallback clipboard
+//    format for other applications
+//---------------------------------------------------------
+
+QByteArray XmlTokens::toXml() const
+      {
+      QString s("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n");
+      std::vector<quint32> stack;
+      const size_t n = _tokens.size();
+      for (size_t i = 0; i < n; ++i) {
+            quint32 t = _tokens[i];
+            switch (t & 3) {
+                  case START: {
+                        stack.push_back(t >> 2);
+                        s += '<';
+                        s += _strings[t >> 2];
+                        quint32 nAttr = _tokens[++i];
+                        for (quint32 k = 0; k < nAttr; ++k) {
+                              s += ' ';
+                              s += _strings[_tokens[i + 1]];
+                              s += "=\"";
+                              s += XmlWriter::xmlString(_strings[_tokens[i + 2]]);
+                              s += '"';
+                              i += 2;
+                              }
+                        if (i + 1 < n && _tokens[i + 1] == END) {
+                              s += "/>";
+                              stack.pop_back();
+                              ++i;
+                              }
+                        else
+                              s += '>';
+                        }
+                        break;
+                  case END:
+                        s += "</";
+                        s += _strings[stack.back()];
+                        s += '>';
+                        stack.pop_back();
+                        break;
+                  case TEXT:
+                        if ((t >> 2) == 0) {
+                              // indentation as written by XmlWriter
+                              s += '\n';
+                              int level = int(stack.size());
+                              if (i + 1 < n && _tokens[i + 1] == END)
+                                    --level;
+                              else if (i + 1 >= n || (_tokens[i + 1] & 3) != START)
+                                    level = 0;
+                              s += QString(level * 2, ' ');
+                              }
+                        else
+                              s += XmlWriter::xmlString(_strings[t >> 2]);
+                        break;
+                  }
+            }
+      return s.toUtf8();
+      }
+
+}
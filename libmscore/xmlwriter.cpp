@@ -69,6 +69,8 @@ void XmlWriter::putLevel()
 
 void XmlWriter::header()
       {
+      if (_tokens)
+            return;
       *this << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n";
       }
 
@@ -79,6 +81,11 @@ void XmlWriter::header()
 
 void XmlWriter::stag(const QString& s)
       {
+      if (_tokens) {
+            _tokens->startElement(s);
+            _tokens->whitespace();
+            return;
+            }
       putLevel();
       *this << '<' << s << '>' << endl;
       stack.append(s.split(' ')[0]);
@@ -101,15 +108,19 @@ void XmlWriter::stag(const ScoreElement* se, const QString& attributes)
 
 void XmlWriter::stag(const QString& name, const ScoreElement* se, const QString& attributes)
       {
+      if (_recordElements)
+            _elements.emplace_back(se, name);
+      if (_tokens) {
+            _tokens->startElement(name, attributes);
+            _tokens->whitespace();
+            return;
+            }
       putLevel();
       *this << '<' << name;
       if (!attributes.isEmpty())
             *this << ' ' << attributes;
       *this << '>' << endl;
       stack.append(name);
-
-      if (_recordElements)
-            _elements.emplace_back(se, name);
       }
 
 //---------------------------------------------------------
@@ -119,6 +130,11 @@ void XmlWriter::stag(const QString& name, const ScoreElement* se, const QString&
 
 void XmlWriter::etag()
       {
+      if (_tokens) {
+            _tokens->endElement();
+            _tokens->whitespace();
+            return;
+            }
       putLevel();
       *this << "</" << stack.takeLast() << '>' << endl;
       }
@@ -132,13 +148,15 @@ void XmlWriter::tagE(const char* format, ...)
       {
       va_list args;
       va_start(args, format);
-      putLevel();
-      *this << '<';
       char buffer[BS];
       vsnprintf(buffer, BS, format, args);
-      *this << buffer;
       va_end(args);
-      *this << "/>" << endl;
+      if (_tokens) {
+            tagE(QString::fromUtf8(buffer));
+            return;
+            }
+      putLevel();
+      *this << '<' << buffer << "/>" << endl;
       }
 
 //---------------------------------------------------------
@@ -147,6 +165,12 @@ void XmlWriter::tagE(const char* format, ...)
 
 void XmlWriter::tagE(const QString& s)
       {
+      if (_tokens) {
+            _tokens->startElement(s);
+            _tokens->endElement();
+            _tokens->whitespace();
+            return;
+            }
       putLevel();
       *this << '<' << s << "/>\n";
       }
@@ -158,6 +182,10 @@ void XmlWriter::tagE(const QString& s)
 
 void XmlWriter::ntag(const char* name)
       {
+      if (_tokens) {
+            _tokens->startElement(QString(name), QString());
+            return;
+            }
       putLevel();
       *this << "<" << name << ">";
       }
@@ -169,6 +197,11 @@ void XmlWriter::ntag(const char* name)
 
 void XmlWriter::netag(const char* s)
       {
+      if (_tokens) {
+            _tokens->endElement();
+            _tokens->whitespace();
+            return;
+            }
       *this << "</" << s << '>' << endl;
       }
 
@@ -191,6 +224,31 @@ void XmlWriter::tag(Pid id, QVariant data, QVariant defaultData)
             tag(name, QVariant(writableVal));
       }
 
+//---------------------------------------------------------
+//   alignString
+//---------------------------------------------------------
+
+static QString alignString(Align a)
+      {
+      const char* h;
+      if (a & Align::HCENTER)
+            h = "center";
+      else if (a & Align::RIGHT)
+            h = "right";
+      else
+            h = "left";
+      const char* v;
+      if (a & Align::BOTTOM)
+            v = "bottom";
+      else if (a & Align::VCENTER)
+            v = "center";
+      else if (a & Align::BASELINE)
+            v = "baseline";
+      else
+            v = "top";
+      return QString("%1,%2").arg(h).arg(v);
+      }
+
 //---------------------------------------------------------
 //   tag
 //    <mops>value</mops>
@@ -204,6 +262,10 @@ void XmlWriter::tag(const char* name, QVariant data, QVariant defaultData)
 
 void XmlWriter::tag(const QString& name, QVariant data)
       {
+      if (_tokens) {
+            tokensTag(name, data);
+            return;
+            }
       QString ename(name.split(' ')[0]);
 
       putLevel();
@@ -277,24 +339,7 @@ void XmlWriter::tag(const QString& name, QVariant data)
                         *this << QString("<%1>%2</%1>\n").arg(name).arg(toString(data.value<Direction>()));
                   else if (strcmp(type, "Ms::Align") == 0) {
                         // TODO: remove from here? (handled in Ms::propertyWritableValue())
-                        Align a = Align(data.toInt());
-                        const char* h;
-                        if (a & Align::HCENTER)
-                              h = "center";
-                        else if (a & Align::RIGHT)
-                              h = "right";
-                        else
-                              h = "left";
-                        const char* v;
-                        if (a & Align::BOTTOM)
-                              v = "bottom";
-                        else if (a & Align::VCENTER)
-                              v = "center";
-                        else if (a & Align::BASELINE)
-                              v = "baseline";
-                        else
-                              v = "top";
-                        *this << QString("<%1>%2,%3</%1>\n").arg(name).arg(h).arg(v);
+                        *this << QString("<%1>%2</%1>\n").arg(name).arg(alignString(Align(data.toInt())));
                         }
                   else {
                         qFatal("XmlWriter::tag: unsupported type %d %s", data.type(), type);
@@ -304,6 +349,86 @@ void XmlWriter::tag(const QString& name, QVariant data)
             }
       }
 
+//---------------------------------------------------------
+//   tokensTag
+//    binary counterpart of tag(); values are converted
+//    to the same strings as in the xml text
+//---------------------------------------------------------
+
+void XmlWriter::tokensTag(const QString& name, const QVariant& data)
+      {
+      QString value;
+      switch(data.type()) {
+            case QVariant::Bool:
+            case QVariant::Char:
+            case QVariant::Int:
+            case QVariant::UInt:
+                  value = QString::number(data.toInt());
+                  break;
+            case QVariant::LongLong:
+                  value = QString::number(data.toLongLong());
+                  break;
+            case QVariant::Double:
+                  value = QString::number(data.value<double>(), 'g', 6);
+                  break;
+            case QVariant::String:
+                  value = data.value<QString>();
+                  break;
+            case QVariant::Color:
+                  {
+                  QColor color(data.value<QColor>());
+                  tagE(QString("%1 r=\"%2\" g=\"%3\" b=\"%4\" a=\"%5\"")
+                     .arg(name).arg(color.red()).arg(color.green()).arg(color.blue()).arg(color.alpha()));
+                  }
+                  return;
+            case QVariant::Rect:
+                  {
+                  const QRect& r(data.value<QRect>());
+                  tagE(QString("%1 x=\"%2\" y=\"%3\" w=\"%4\" h=\"%5\"").arg(name).arg(r.x()).arg(r.y()).arg(r.width()).arg(r.height()));
+                  }
+                  return;
+            case QVariant::RectF:
+                  {
+                  const QRectF& r(data.value<QRectF>());
+                  tagE(QString("%1 x=\"%2\" y=\"%3\" w=\"%4\" h=\"%5\"").arg(name).arg(r.x()).arg(r.y()).arg(r.width()).arg(r.height()));
+                  }
+                  return;
+            case QVariant::PointF:
+                  {
+                  const QPointF& p(data.value<QPointF>());
+                  tagE(QString("%1 x=\"%2\" y=\"%3\"").arg(name).arg(p.x()).arg(p.y()));
+                  }
+                  return;
+            case QVariant::SizeF:
+                  {
+                  const QSizeF& p(data.value<QSizeF>());
+                  tagE(QString("%1 w=\"%2\" h=\"%3\"").arg(name).arg(p.width()).arg(p.height()));
+                  }
+                  return;
+            default: {
+                  const char* type = data.typeName();
+                  if (strcmp(type, "Ms::Spatium") == 0)
+                        value = QString::number(data.value<Spatium>().val(), 'g', 6);
+                  else if (strcmp(type, "Ms::Fraction") == 0) {
+                        const Fraction& f = data.value<Fraction>();
+                        value = QString("%1/%2").arg(f.numerator()).arg(f.denominator());
+                        }
+                  else if (strcmp(type, "Ms::Direction") == 0)
+                        value = toString(data.value<Direction>());
+                  else if (strcmp(type, "Ms::Align") == 0)
+                        value = alignString(Align(data.toInt()));
+                  else {
+                        qFatal("XmlWriter::tag: unsupported type %d %s", data.type(), type);
+                        }
+                  }
+                  break;
+            }
+      _tokens->startElement(name);
+      _tokens->text(value);
+      _tokens->endElement();
+      _tokens->whitespace();
+      }
+
 void XmlWriter::tag(const char* name, const QWidget* g)
       {
       tag(name, QRect(g->pos(), g->size()));
@@ -315,6 +440,8 @@ void XmlWriter::tag(const char* name, const QWidget* g)
 
 void XmlWriter::comment(const QString& text)
       {
+      if (_tokens)
+            return;
       putLevel();
       *this << "<!-- " << text << " -->" << endl;
       }
@@ -363,6 +490,16 @@ QString XmlWriter::xmlString(const QString& s)
 
 void XmlWriter::dump(int len, const unsigned char* p)
       {
+      if (_tokens) {
+            // only used for diagnostics, keep the text form
+            QString s;
+            XmlWriter xml(_score);
+            xml.setString(&s, QIODevice::WriteOnly);
+            xml.dump(len, p);
+            xml.flush();
+            _tokens->text(s);
+            return;
+            }
       putLevel();
       int col = 0;
       setFieldWidth(5);
@@ -398,6 +535,13 @@ void XmlWriter::writeXml(const QString& name, QString s)
             if (c < 0x20 && c != 0x09 && c != 0x0A && c != 0x0D)
                   s[i] = '?';
             }
+      if (_tokens) {
+            _tokens->startElement(name);
+            _tokens->xmlFragment(s);
+            _tokens->endElement();
+            _tokens->whitespace();
+            return;
+            }
       *this << "<" << name << ">";
       *this << s;
       *this << "</" << ename << ">\n";
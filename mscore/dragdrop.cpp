@@ -41,11 +41,13 @@ void ScoreView::setDropTarget(const Element* el)
       if (dropTarget != el) {
             if (dropTarget) {
                   dropTarget->setDropTarget(false);
+                  invalidateTiles(dropTarget->canvasBoundingRect());
                   dropTarget = 0;
                   }
             dropTarget = el;
             if (dropTarget) {
                   dropTarget->setDropTarget(true);
+                  invalidateTiles(dropTarget->canvasBoundingRect());
                   }
             }
       if (!dropAnchor.isNull()) {
@@ -72,6 +74,7 @@ void ScoreView::setDropRectangle(const QRectF& r)
       if (dropTarget) {
             dropTarget->setDropTarget(false);
             _score->addRefresh(dropTarget->canvasBoundingRect());
+            invalidateTiles(dropTarget->canvasBoundingRect());
             dropTarget = 0;
             }
       else if (!dropAnchor.isNull()) {
@@ -909,8 +909,7 @@ void ScoreView::escapeCmd()
                   changeState(ViewState::NORMAL);
                   break;
             case ViewState::NORMAL:
-                  _score->deselectAll();
-                  update();
+                  deselectAll();
                   break;
             default:
                   break;
@@ -502,18 +502,20 @@ ExcerptItem* ExcerptsDialog::isInPartsList(Excerpt* e)
       }
 
 //---------------------------------------------------------
-//   createExcerpt
+//   addExcerpt
+//    Add the excerpt of a new part to the score, its part
+//    score is created by accept() together with the others
 //---------------------------------------------------------
 
-void ExcerptsDialog::createExcerptClicked(QListWidgetItem* cur)
+Excerpt* ExcerptsDialog::addExcerpt(QListWidgetItem* cur)
       {
       Excerpt* e = static_cast<ExcerptItem*>(cur)->excerpt();
       e->setTitle(title->text());
       if (e->partScore())
-            return;
+            return 0;
       if (e->parts().isEmpty()) {
             qDebug("no parts");
-            return;
+            return 0;
             }
 
       Score* nscore = new Score(e->oscore());
@@ -521,18 +523,10 @@ void ExcerptsDialog::createExcerptClicked(QListWidgetItem* cur)
 
       qDebug() << " + Add part : " << e->title();
       score->undo(new AddExcerpt(e));
-      Excerpt::createExcerpt(e);
-
-      // a new excerpt is created in AddExcerpt, make sure the parts are filed
-      for (Excerpt* ee : e->oscore()->excerpts()) {
-            if (ee->partScore() == nscore && ee != e) {
-                  ee->parts().clear();
-                  ee->parts().append(e->parts());
-                  }
-            }
 
       partList->setEnabled(false);
       title->setEnabled(false);
+      return e;
       }
 
 //---------------------------------------------------------
@@ -555,13 +549,27 @@ void ExcerptsDialog::accept()
                   }
             }
       // Second pass : Create new parts
+      QList<Excerpt*> newExcerpts;
       int n = excerptList->count();
       for (int i = 0; i < n; ++i) {
             excerptList->setCurrentRow(i);
             QListWidgetItem* cur = excerptList->currentItem();
             if (cur == 0)
                   continue;
-            createExcerptClicked(cur);
+            Excerpt* e = addExcerpt(cur);
+            if (e)
+                  newExcerpts.append(e);
+            }
+      Excerpt::createExcerpts(newExcerpts);
+
+      // a new excerpt is created in AddExcerpt, make sure the parts are filed
+      for (Excerpt* e : newExcerpts) {
+            for (Excerpt* ee : e->oscore()->excerpts()) {
+                  if (ee->partScore() == e->partScore() && ee != e) {
+                        ee->parts().clear();
+                        ee->parts().append(e->parts());
+                        }
+                  }
             }
 
       // Third pass : Remove empty parts.
@@ -103,9 +103,9 @@ class ExcerptsDialog : public QDialog, private Ui::ExcerptsDialog {
       void excerptChanged(QListWidgetItem* cur, QListWidgetItem* prev);
       void partDoubleClicked(QTreeWidgetItem*, int);
       void partClicked(QTreeWidgetItem*, int);
-      void createExcerptClicked(QListWidgetItem*);
       void titleChanged(const QString&);
       ExcerptItem* isInPartsList(Excerpt* e);
+      Excerpt* addExcerpt(QListWidgetItem*);
 
       QMultiMap<int, int> mapTracks();
       void assignTracks(QMultiMap<int, int> );
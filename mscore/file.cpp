@@ -781,8 +781,8 @@ MasterScore* MuseScore::getNewFile()
             x->setPartScore(xs);
             xs->setExcerpt(x);
             score->excerpts().append(x);
-            Excerpt::createExcerpt(x);
             }
+      Excerpt::createExcerpts(excerpts);
       score->setExcerptsChanged(true);
       return score;
       }
@@ -115,7 +115,7 @@ void ScoreView::stopFotomode()
       a->setChecked(false);
       _foto->setVisible(false);
       endEdit();
-      update();
+      _score->update();
       }
 
 //---------------------------------------------------------
@@ -204,55 +204,179 @@ void findAllTupletsForDrums(
       // note: temporary local tuplets and chords are deleted here
       }
 
+void quantizeTrack(MTrack &mtrack,
+                   TimeSigMap *sigmap,
+                   const ReducedFraction &lastTick)
+      {
+      const auto &opers = midiImportOperations;
+                  // pass current track index through MidiImportOperations
+                  // for further usage; the setter is local to this thread
+      MidiOperations::CurrentTrackSetter setCurrentTrack{midiImportOperations, mtrack.indexOfOperation};
+
+      const auto basicQuant = Quantize::quantValueToFraction(
+                  opers.data()->trackOpers.quantValue.value(mtrack.indexOfOperation));
+
+      Q_ASSERT_X(MChord::isLastTickValid(lastTick, mtrack.chords),
+                 "quantizeTrack", "Last tick is less than max note off time");
+
+      MChord::setBarIndexes(mtrack.chords, basicQuant, lastTick, sigmap);
+
+      if (mtrack.mtrack->drumTrack())
+            findAllTupletsForDrums(mtrack, sigmap, basicQuant);
+      else
+            MidiTuplet::findAllTuplets(mtrack.tuplets, mtrack.chords, sigmap, basicQuant);
+
+      Q_ASSERT_X(!doNotesOverlap(mtrack),
+                 "quantizeTrack",
+                 "There are overlapping notes of the same voice that is incorrect");
+
+                  // (4/3 of the smallest duration) tol is less sensitive
+                  // to on time inaccuracies than 1/2 earlier
+      MChord::collectChords(mtrack, {2, 1}, {4, 3});
+      Quantize::quantizeChords(mtrack.chords, sigmap, basicQuant);
+      MidiTuplet::removeEmptyTuplets(mtrack);
+
+      Q_ASSERT_X(MidiTuplet::areTupletRangesOk(mtrack.chords, mtrack.tuplets),
+                 "quantizeTrack", "Tuplet chord/note is outside tuplet "
+                  "or non-tuplet chord/note is inside tuplet");
+      }
+
+std::vector<int> quantizationOpers(const MTrack &mtrack)
+      {
+      const auto &opers = midiImportOperations.data()->trackOpers;
+      const int track = mtrack.indexOfOperation;
+
+      return {
+            (int)opers.quantValue.value(track),
+            opers.searchTuplets.value(track),
+            opers.search2plets.value(track),
+            opers.search3plets.value(track),
+            opers.search4plets.value(track),
+            opers.search5plets.value(track),
+            opers.search7plets.value(track),
+            opers.search9plets.value(track),
+            opers.simplifyDurations.value(track),
+            (int)opers.maxVoiceCount.value(track),
+            opers.isHumanPerformance.value(),
+            mtrack.mtrack->drumTrack()
+            };
+      }
+
+bool areNotesEqual(const QList<MidiNote> &notes1, const QList<MidiNote> &notes2)
+      {
+      if (notes1.size() != notes2.size())
+            return false;
+      for (int i = 0; i != notes1.size(); ++i) {
+            const MidiNote &n1 = notes1[i];
+            const MidiNote &n2 = notes2[i];
+            if (n1.pitch != n2.pitch || n1.velo != n2.velo || n1.offTime != n2.offTime
+                        || n1.staccato != n2.staccato || n1.origOnTime != n2.origOnTime) {
+                  return false;
+                  }
+            }
+      return true;
+      }
+
+// compare tracks before quantization: there are no tuplets yet
+
+bool isSameQuantSource(const MTrack &track1, const MTrack &track2)
+      {
+      if (!track1.tuplets.empty() || !track2.tuplets.empty())
+            return false;
+      if (track1.chords.size() != track2.chords.size())
+            return false;
+      for (auto it1 = track1.chords.begin(), it2 = track2.chords.begin();
+                  it1 != track1.chords.end(); ++it1, ++it2) {
+            if (it1->first != it2->first || it1->second.voice != it2->second.voice
+                        || !areNotesEqual(it1->second.notes, it2->second.notes)) {
+                  return false;
+                  }
+            }
+      return true;
+      }
+
+const MidiOperations::QuantizedTrack* findQuantizedTrack(
+            const std::multimap<int, MidiOperations::QuantizedTrack> &quantizedTracks,
+            const MTrack &mtrack,
+            const std::vector<int> &opers)
+      {
+      const auto range = quantizedTracks.equal_range(mtrack.indexOfOperation);
+      for (auto it = range.first; it != range.second; ++it) {
+            if (it->second.opers == opers && isSameQuantSource(it->second.source, mtrack))
+                  return &it->second;
+            }
+      return nullptr;
+      }
+
 void quantizeAllTracks(std::multimap<int, MTrack> &tracks,
                        TimeSigMap *sigmap,
                        const ReducedFraction &lastTick)
       {
       auto &opers = midiImportOperations;
+      auto *data = opers.data();
+                  // cached results are valid only for the same bars
+      if (data->quantizedTracksLastTick != lastTick
+                  || data->quantizedTracksSigmap != static_cast<const std::map<int, SigEvent> &>(*sigmap)) {
+            data->quantizedTracks.clear();
+            }
+
+      std::multimap<int, MidiOperations::QuantizedTrack> quantizedTracks;
+      std::vector<MTrack *> tracksToQuantize;
+      std::vector<MidiOperations::QuantizedTrack *> newQuantizedTracks;
 
       for (auto &track: tracks) {
             MTrack &mtrack = track.second;
             if (mtrack.chords.empty())
                   continue;
-                        // pass current track index through MidiImportOperations
-                        // for further usage
-            MidiOperations::CurrentTrackSetter setCurrentTrack{opers, mtrack.indexOfOperation};
-
-            if (opers.data()->processingsOfOpenedFile == 0) {
-                  opers.data()->trackOpers.isDrumTrack.setValue(
-                                          opers.currentTrack(), mtrack.mtrack->drumTrack());
+                        // operations are modified here, before the parallel part,
+                        // so the quantization below only reads them
+            if (data->processingsOfOpenedFile == 0) {
+                  data->trackOpers.isDrumTrack.setValue(
+                                          mtrack.indexOfOperation, mtrack.mtrack->drumTrack());
                   if (mtrack.mtrack->drumTrack()) {
-                        opers.data()->trackOpers.maxVoiceCount.setValue(
-                                          opers.currentTrack(), MidiOperations::VoiceCount::V_1);
+                        data->trackOpers.maxVoiceCount.setValue(
+                                          mtrack.indexOfOperation, MidiOperations::VoiceCount::V_1);
                         }
                   }
-            const auto basicQuant = Quantize::quantValueToFraction(
-                        opers.data()->trackOpers.quantValue.value(mtrack.indexOfOperation));
-
-            Q_ASSERT_X(MChord::isLastTickValid(lastTick, mtrack.chords),
-                       "quantizeAllTracks", "Last tick is less than max note off time");
 
-            MChord::setBarIndexes(mtrack.chords, basicQuant, lastTick, sigmap);
-
-            if (mtrack.mtrack->drumTrack())
-                  findAllTupletsForDrums(mtrack, sigmap, basicQuant);
-            else
-                  MidiTuplet::findAllTuplets(mtrack.tuplets, mtrack.chords, sigmap, basicQuant);
+            const auto quantOpers = quantizationOpers(mtrack);
+            const auto *cached = findQuantizedTrack(data->quantizedTracks, mtrack, quantOpers);
+            if (cached) {
+                              // copy updates the tuplet iterators of chords,
+                              // swap keeps them valid
+                  MTrack result = cached->result;
+                  mtrack.chords.swap(result.chords);
+                  mtrack.tuplets.swap(result.tuplets);
+                  quantizedTracks.insert({mtrack.indexOfOperation, *cached});
+                  continue;
+                  }
 
-            Q_ASSERT_X(!doNotesOverlap(track.second),
-                       "quantizeAllTracks",
-                       "There are overlapping notes of the same voice that is incorrect");
+            auto it = quantizedTracks.insert({mtrack.indexOfOperation,
+                                              MidiOperations::QuantizedTrack()});
+            it->second.opers = quantOpers;
+            it->second.source = mtrack;
+            newQuantizedTracks.push_back(&it->second);
+            tracksToQuantize.push_back(&mtrack);
+            }
+                  // tracks are independent of each other and every track
+                  // is changed only by its own task, so the result is the same
+                  // as for the sequential processing
+      if (tracksToQuantize.size() < 2) {
+            for (MTrack *mtrack: tracksToQuantize)
+                  quantizeTrack(*mtrack, sigmap, lastTick);
+            }
+      else {
+            QtConcurrent::blockingMap(tracksToQuantize, [sigmap, &lastTick](MTrack *mtrack) {
+                  quantizeTrack(*mtrack, sigmap, lastTick);
+                  });
+            }
 
-                        // (4/3 of the smallest duration) tol is less sensitive
-                        // to on time inaccuracies than 1/2 earlier
-            MChord::collectChords(mtrack, {2, 1}, {4, 3});
-            Quantize::quantizeChords(mtrack.chords, sigmap, basicQuant);
-            MidiTuplet::removeEmptyTuplets(mtrack);
+      for (size_t i = 0; i != tracksToQuantize.size(); ++i)
+            newQuantizedTracks[i]->result = *tracksToQuantize[i];
 
-            Q_ASSERT_X(MidiTuplet::areTupletRangesOk(mtrack.chords, mtrack.tuplets),
-                       "quantizeAllTracks", "Tuplet chord/note is outside tuplet "
-                        "or non-tuplet chord/note is inside tuplet");
-            }
+      data->quantizedTracks.swap(quantizedTracks);
+      data->quantizedTracksSigmap = *sigmap;
+      data->quantizedTracksLastTick = lastTick;
       }
 
 //---------------------------------------------------------
@@ -7,6 +7,8 @@ MidiOperations::Data midiImportOperations;
 
 namespace MidiOperations {
 
+thread_local int Data::_currentTrack = -1;
+
 static int readBoolFromXml(QXmlStreamReader &xml)
       {
       int value = -1;
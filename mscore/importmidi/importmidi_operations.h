@@ -4,6 +4,7 @@
 #include "importmidi_inner.h"
 #include "importmidi_operation.h"
 #include "midi/midifile.h"
+#include "libmscore/sig.h"
 
 
 namespace Ms {
@@ -189,6 +190,13 @@ struct HumanBeatData
       bool measureCount2xLess = false;
       };
 
+struct QuantizedTrack
+      {
+      std::vector<int> opers;       // values of track operations that affect quantization
+      MTrack source;                // track before quantization
+      MTrack result;                // track after quantization
+      };
+
 struct FileData
       {
       MidiFile midiFile;
@@ -208,6 +216,12 @@ struct FileData
       QList<std::multimap<ReducedFraction, std::string>> lyricTracks;
       std::multimap<ReducedFraction, QString> chordNames;
       HumanBeatData humanBeatData;
+                  // tracks quantized by the previous processing, <track index, ...>;
+                  // the user usually changes options of one track at a time,
+                  // so unchanged tracks are not quantized again
+      std::multimap<int, QuantizedTrack> quantizedTracks;
+      std::map<int, SigEvent> quantizedTracksSigmap;
+      ReducedFraction quantizedTracksLastTick;
       };
 
 class Data
@@ -231,12 +245,13 @@ class Data
 
       QString _currentMidiFile;
       QString _midiOperationsFile;
-      int _currentTrack = -1;
+                  // per thread: tracks can be quantized in parallel
+      static thread_local int _currentTrack;
 
       std::map<QString, FileData> _data;    // <file name, tracks data>
       };
 
-// scoped setter of current track
+// scoped setter of current track, affects only the calling thread
 class CurrentTrackSetter
       {
    public:
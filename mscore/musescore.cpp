@@ -123,6 +123,7 @@
 #include "help.h"
 #include "awl/aslider.h"
 #include "extension.h"
+#include "startupcache.h"
 #include "thirdparty/qzip/qzipreader_p.h"
 
 #include "sparkle/autoUpdater.h"
@@ -186,6 +187,9 @@ bool exportScoreMedia = false;
 bool exportScoreMeta = false;
 bool exportScoreMp3 = false;
 bool exportScorePartsPdf = false;
+static bool audioBenchmarkMode = false;
+static int audioBenchmarkPeriod = 256;
+static int audioBenchmarkRate = 44100;
 
 QString mscoreGlobalShare;
 
@@ -427,6 +431,7 @@ void updateExternalValuesFromPreferences() {
       MScore::panPlayback = preferences.getBool(PREF_APP_PLAYBACK_PANPLAYBACK);
       MScore::playRepeats = preferences.getBool(PREF_APP_PLAYBACK_PLAYREPEATS);
       MScore::warnPitchRange = preferences.getBool(PREF_SCORE_NOTE_WARNPITCHRANGE);
+      MScore::undoMemoryLimit = preferences.getInt(PREF_APP_UNDO_MEMORYLIMIT);
       MScore::layoutBreakColor = preferences.getColor(PREF_UI_SCORE_LAYOUTBREAKCOLOR);
       MScore::frameMarginColor = preferences.getColor(PREF_UI_SCORE_FRAMEMARGINCOLOR);
       MScore::setVerticalOrientation(preferences.getBool(PREF_UI_CANVAS_SCROLL_VERTICALORIENTATION));
@@ -467,6 +472,8 @@ void MuseScore::preferencesChanged(bool fromWorkspace)
 
       setPlayRepeats(MScore::playRepeats);
       getAction("pan")->setChecked(MScore::panPlayback);
+      for (MasterScore* s : scoreList)
+            s->undoStack()->setMemoryLimit(size_t(MScore::undoMemoryLimit) * 1024 * 1024);
       getAction("follow")->setChecked(preferences.getBool(PREF_APP_PLAYBACK_FOLLOWSONG));
       getAction("midi-on")->setEnabled(preferences.getBool(PREF_IO_MIDI_ENABLEINPUT));
       getAction("toggle-statusbar")->setChecked(preferences.getBool(PREF_UI_APP_SHOWSTATUSBAR));
@@ -2492,14 +2499,13 @@ void MuseScore::openRecentMenu()
 
 void MuseScore::reloadInstrumentTemplates()
       {
-      clearInstrumentTemplates();
-      // load cascading instrument templates
-      loadInstrumentTemplates(preferences.getString(PREF_APP_PATHS_INSTRUMENTLIST1));
+      // cascading instrument templates
+      QStringList files(preferences.getString(PREF_APP_PATHS_INSTRUMENTLIST1));
       QString list2 = preferences.getString(PREF_APP_PATHS_INSTRUMENTLIST2);
       if (!list2.isEmpty())
-            loadInstrumentTemplates(list2);
+            files.append(list2);
 
-      // load instrument templates from extension
+      // instrument templates from extension
       QStringList extensionDir = Extension::getDirectoriesByType(Extension::instrumentsDir);
       QStringList filter("*.xml");
       for (QString s : extensionDir) {
@@ -2507,9 +2513,23 @@ void MuseScore::reloadInstrumentTemplates()
             extDir.setNameFilters(filter);
             auto instFiles = extDir.entryInfoList(QDir::Files | QDir::NoSymLinks | QDir::Readable);
             for (auto instFile : instFiles)
-                  loadInstrumentTemplates(instFile.absoluteFilePath());
+                  files.append(instFile.absoluteFilePath());
             }
 
+      // template names are translated while reading, so the
+      // installed instrument translations are part of the key
+      QStringList sources(files);
+      for (const QFileInfo& fi : QDir(dataPath + "/locale").entryInfoList(QStringList("instruments_*.qm"), QDir::Files))
+            sources.append(fi.absoluteFilePath());
+      StartupCache cache("instruments", sources);
+      if (!cache.read(loadInstrumentTemplatesCache)) {
+            clearInstrumentTemplates();
+            for (const QString& file : files)
+                  loadInstrumentTemplates(file);
+            cache.write(saveInstrumentTemplatesCache);
+            }
+      StartupProfile::mark("instrument templates");
+
       MidiInstr::instrumentTemplatesChanged();
       if (importmidiPanel)
             importmidiPanel->instrumentTemplatesChanged();
@@ -3599,15 +3619,15 @@ static bool doConvert(Score *cs, const QString& fn)
             if (cs->excerpts().size() == 0) {
                   auto excerpts = Excerpt::createAllExcerpt(cs->masterScore());
 
+                  cs->startCmd();
                   for (Excerpt* e : excerpts) {
                         Score* nscore = new Score(e->oscore());
                         e->setPartScore(nscore);
                         nscore->style().set(Sid::createMultiMeasureRests, true);
-                        cs->startCmd();
                         cs->undo(new AddExcerpt(e));
-                        Excerpt::createExcerpt(e);
-                        cs->endCmd();
                         }
+                  Excerpt::createExcerpts(excerpts);
+                  cs->endCmd();
                   }
             QList<Score*> scores;
             scores.append(cs);
@@ -3621,17 +3641,17 @@ static bool doConvert(Score *cs, const QString& fn)
             if (cs->excerpts().size() == 0) {
                   auto excerpts = Excerpt::createAllExcerpt(cs->masterScore());
 
+                  cs->startCmd();
                   for (Excerpt* e: excerpts) {
                         Score* nscore = new Score(e->oscore());
                         e->setPartScore(nscore);
                         nscore->setExcerpt(e);
                         // nscore->setName(e->title()); // needed before AddExcerpt
                         nscore->style().set(Sid::createMultiMeasureRests, true);
-                        cs->startCmd();
                         cs->undo(new AddExcerpt(e));
-                        Excerpt::createExcerpt(e);
-                        cs->endCmd();
                         }
+                  Excerpt::createExcerpts(excerpts);
+                  cs->endCmd();
                   }
             if (!mscore->savePng(cs, fn))
                   return false;
@@ -3763,6 +3783,8 @@ static bool processNonGui(const QStringList& argv)
             return mscore->exportMp3AsJSON(argv[0]);
       else if (exportScorePartsPdf)
             return mscore->exportPartsPdfsToJSON(argv[0]);
+      else if (audioBenchmarkMode)
+            return mscore->audioBenchmark(argv[0], "/dev/stdout", audioBenchmarkPeriod, audioBenchmarkRate);
 
       if (pluginMode) {
             loadScores(argv);
@@ -5903,7 +5925,7 @@ void MuseScore::endCmd()
       getPluginEngine()->beginEndCmd(this);
 #endif
       if (timeline())
-            timeline()->updateGrid();
+            timeline()->updateGrid(false);
       if (MScore::_error != MS_NO_ERROR)
             showError();
       if (cs) {
@@ -7358,6 +7380,10 @@ int main(int argc, char* av[])
       parser.addOption(QCommandLineOption("score-parts-pdf", "Generates parts data for the given score and export the data to a single JSON file, print it to std out"));
       parser.addOption(QCommandLineOption("raw-diff", "Print a raw diff for the given scores"));
       parser.addOption(QCommandLineOption("diff", "Print a diff for the given scores"));
+      parser.addOption(QCommandLineOption("startup-profile", "Print the time spent in the startup phases"));
+      parser.addOption(QCommandLineOption("audio-benchmark", "Play the given score through a null audio driver as fast as possible and print render time statistics as JSON to std out"));
+      parser.addOption(QCommandLineOption("audio-benchmark-period", "Used with '--audio-benchmark', sets the period size in frames", "frames"));
+      parser.addOption(QCommandLineOption("audio-benchmark-rate", "Used with '--audio-benchmark', sets the sample rate", "rate"));
 
       parser.addPositionalArgument("scorefiles", "The files to open", "[scorefile...]");
 
@@ -7520,6 +7546,28 @@ int main(int argc, char* av[])
             converterMode = true;
             }
 
+      if (parser.isSet("audio-benchmark")) {
+            audioBenchmarkMode = true;
+            MScore::noGui = true;
+            converterMode = true;
+            }
+      if (parser.isSet("audio-benchmark-period")) {
+            bool ok = false;
+            int frames = parser.value("audio-benchmark-period").toInt(&ok);
+            if (ok && frames >= 16 && frames <= MasterSynthesizer::MAX_BUFFERSIZE / 2)
+                  audioBenchmarkPeriod = frames;
+            else
+                  fprintf(stderr, "Period size '%s' not recognized, using %d frames instead.\n", qPrintable(parser.value("audio-benchmark-period")), audioBenchmarkPeriod);
+            }
+      if (parser.isSet("audio-benchmark-rate")) {
+            bool ok = false;
+            int rate = parser.value("audio-benchmark-rate").toInt(&ok);
+            if (ok && rate > 0)
+                  audioBenchmarkRate = rate;
+            else
+                  fprintf(stderr, "Sample rate '%s' not recognized, using %d instead.\n", qPrintable(parser.value("audio-benchmark-rate")), audioBenchmarkRate);
+            }
+
       if (parser.isSet("raw-diff")) {
             MScore::noGui = true;
             rawDiffMode = true;
@@ -7528,6 +7576,8 @@ int main(int argc, char* av[])
             MScore::noGui = true;
             diffMode = true;
             }
+      if (parser.isSet("startup-profile"))
+            StartupProfile::start();
       if (parser.isSet("run-test-script")) {
             if (rawDiffMode || diffMode)
                   qFatal("incompatible options");
@@ -7597,11 +7647,13 @@ int main(int argc, char* av[])
 
       Shortcut::init();
       preferences.init();
+      StartupProfile::mark("locale, shortcuts and preferences");
 
       QNetworkProxyFactory::setUseSystemConfiguration(true);
 
       MScore::init();         // initialize libmscore
       updateExternalValuesFromPreferences();
+      StartupProfile::mark("libmscore");
 
       // initialize current page size from default printer
 #ifndef QT_NO_PRINTER
@@ -7643,6 +7695,7 @@ int main(int argc, char* av[])
 
       if (!MScore::testMode)
             MScore::readDefaultStyle(preferences.getString(PREF_SCORE_STYLE_DEFAULTSTYLEFILE));
+      StartupProfile::mark("default style");
 
       QSplashScreen* sc = 0;
       if (!MScore::noGui && preferences.getBool(PREF_UI_APP_STARTUP_SHOWSPLASHSCREEN)) {
@@ -7665,6 +7718,7 @@ int main(int argc, char* av[])
             genIcons(); // in GUI mode generated in updateUiStyleAndTheme()
             noSeq = true;
             }
+      StartupProfile::mark("ui style and icons");
 
       // Do not create sequencer and audio drivers if run with '-s'
       if (!noSeq) {
@@ -7692,6 +7746,7 @@ int main(int argc, char* av[])
             seq         = 0;
             MScore::seq = 0;
             }
+      StartupProfile::mark("audio drivers and synthesizer");
 //---
       //
       // avoid font problems by overriding the environment
@@ -7718,9 +7773,11 @@ int main(int argc, char* av[])
             qApp->setWindowIcon(*icons[int(Icons::window_ICON)]);
 #endif
             WorkspacesManager::initCurrentWorkspace();
+            StartupProfile::mark("workspaces");
             }
 
       mscore = new MuseScore();
+      StartupProfile::mark("main window");
       // create a score for internal use
       gscore = new MasterScore();
       gscore->setPaletteMode(true);
@@ -7731,6 +7788,7 @@ int main(int argc, char* av[])
       ScoreFont* scoreFont = ScoreFont::fontFactory("Bravura");
       gscore->setScoreFont(scoreFont);
       gscore->setNoteHeadWidth(scoreFont->width(SymId::noteheadBlack, gscore->spatium()) / SPATIUM20);
+      StartupProfile::mark("score font");
 
       //read languages list
       mscore->readLanguages(mscoreGlobalShare + "locale/languages.xml");
@@ -7787,6 +7845,7 @@ int main(int argc, char* av[])
             // see issue #28706: Hangup in converter mode with MusicXML source
             qApp->processEvents();
 #endif
+            StartupProfile::report();
             exit(processNonGui(argv) ? 0 : EXIT_FAILURE);
             }
       else {
@@ -7815,6 +7874,7 @@ int main(int argc, char* av[])
             // TODO: delete old session backups
             //
             restoredSession = mscore->restoreSession((preferences.sessionStart() == SessionStart::LAST && (files == 0)));
+            StartupProfile::mark("session");
             }
 
       errorMessage = new QErrorMessage(mscore);
@@ -7835,9 +7895,11 @@ int main(int argc, char* av[])
 
       mscore->changeState(mscore->noScore() ? STATE_DISABLED : STATE_NORMAL);
       mscore->show();
+      StartupProfile::mark("plugins and show main window");
 
       if (!restoredSession || files)
             loadScores(argv);
+      StartupProfile::mark("scores");
 
       if (mscore->hasToCheckForExtensionsUpdate())
             mscore->checkForExtensionsUpdate();
@@ -7881,6 +7943,7 @@ int main(int argc, char* av[])
       if (settings.value("synthControlVisible", false).toBool())
             mscore->showSynthControl(true);
 
+      StartupProfile::report();
       return qApp->exec();
       }
 
@@ -7920,8 +7983,8 @@ bool MuseScore::exportPartsPdfsToJSON(const QString& inFilePath, const QString&
                   nscore->style().set(Sid::createMultiMeasureRests, true);
                   auto excerptCmdFake = new AddExcerpt(e);
                   excerptCmdFake->redo(nullptr);
-                  Excerpt::createExcerpt(e);
             }
+            Excerpt::createExcerpts(excerpts);
       }
 
       QList<Score*> scores;
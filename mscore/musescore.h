@@ -775,6 +775,7 @@ class MuseScore : public QMainWindow, public MuseScoreCore {
       bool exportAllMediaFiles(const QString& inFilePath, const QString& outFilePath = "/dev/stdout");
       bool exportScoreMetadata(const QString& inFilePath, const QString& outFilePath = "/dev/stdout");
       bool exportMp3AsJSON(const QString& inFilePath, const QString& outFilePath = "/dev/stdout");
+      bool audioBenchmark(const QString& inFilePath, const QString& outFilePath = "/dev/stdout", int periodSize = 256, int sampleRate = 44100);
       bool exportPartsPdfsToJSON(const QString& inFilePath, const QString& outFilePath = "/dev/stdout");
       /////////////////////////////////////////////////
 
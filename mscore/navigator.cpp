@@ -19,6 +19,7 @@
 #include "libmscore/mscore.h"
 #include "libmscore/system.h"
 #include "libmscore/measurebase.h"
+#include "libmscore/measure.h"
 
 namespace Ms {
 
@@ -125,6 +126,10 @@ Navigator::Navigator(NScrollArea* sa, QWidget* parent)
       sa->setWidget(this);
       sa->setWidgetResizable(false);
       _previewOnly = false;
+      renderTimer  = new QTimer(this);
+      renderTimer->setSingleShot(true);
+      renderTimer->setInterval(0);
+      connect(renderTimer, SIGNAL(timeout()), SLOT(renderPendingThumbnails()));
       }
 
 //---------------------------------------------------------
@@ -150,6 +155,8 @@ void Navigator::setScoreView(ScoreView* v)
             disconnect(_cv, SIGNAL(viewRectChanged()), this, SLOT(updateViewRect()));
             }
       _cv = QPointer<ScoreView>(v);
+      thumbnails.clear();
+      pendingPages.clear();
       if (v) {
             _score  = v->score();
             rescale();
@@ -175,6 +182,7 @@ void Navigator::setScore(Score* v)
       {
       setScoreView(nullptr); // ensure all connections to ScoreView get disconnected
       _score = v;
+      invalidateThumbnails();
       rescale();
       updateViewRect();
       update();
@@ -203,6 +211,8 @@ void Navigator::rescale()
             qreal scoreHeight = lp->y() + lp->height();
             qreal m = width() / scoreWidth;
             setFixedHeight(int(scoreHeight * m));
+            if (m != matrix.m11())
+                  invalidateThumbnails();
             matrix = QTransform(m, 0, 0, m, 0, 0);
             }
       else {
@@ -212,6 +222,8 @@ void Navigator::rescale()
                   scoreWidth = lp->width() * _score->pages().size();
             qreal m  = height() / scoreHeight;
             setFixedWidth(int(scoreWidth * m));
+            if (m != matrix.m11())
+                  invalidateThumbnails();
             matrix = QTransform(m, 0, 0, m, 0, 0);
             }
       }
@@ -327,19 +339,147 @@ static void paintElement(void* data, Element* e)
       p->translate(-pos);
       }
 
+//---------------------------------------------------------
+//   pageTick
+//---------------------------------------------------------
+
+static Fraction pageTick(const Page* page)
+      {
+      if (page->systems().empty() || page->systems().front()->measures().empty())
+            return Fraction(-1, 1);
+      return page->systems().front()->measures().front()->tick();
+      }
+
+//---------------------------------------------------------
+//   invalidateThumbnails
+//    the old pixmaps are shown until the new ones are
+//    rendered
+//---------------------------------------------------------
+
+void Navigator::invalidateThumbnails()
+      {
+      for (PageThumbnail& t : thumbnails)
+            t.valid = false;
+      }
+
 //---------------------------------------------------------
 //   layoutChanged
+//    invalidate the thumbnails of the pages in the
+//    layout range of the current command and of all
+//    pages with a different set of measures or systems
 //---------------------------------------------------------
 
 void Navigator::layoutChanged()
       {
-      if (_score && !_score->pages().isEmpty())
+      if (!_score)
+            return;
+      const QList<Page*>& pages = _score->pages();
+      thumbnails.resize(pages.size());
+
+      const CmdState& cs = _score->masterScore()->cmdState();
+      if (cs.layoutRange()) {
+            const Fraction stick = cs.startTick();
+            const Fraction etick = cs.endTick();
+            for (int i = 0; i < pages.size(); ++i) {
+                  const Page* page    = pages[i];
+                  PageThumbnail& t    = thumbnails[i];
+                  const Fraction tick = pageTick(page);
+                  const Fraction end  = page->endTick();
+                  if (t.tick != tick || t.endTick != end || t.systems != page->systems().size())
+                        t.valid = false;
+                  else if (end > stick && (etick < Fraction(0, 1) || tick <= etick))
+                        t.valid = false;
+                  }
+            }
+      else
+            invalidateThumbnails();
+
+      if (!pages.isEmpty())
             rescale();
       update();
       }
 
+//---------------------------------------------------------
+//   dataChanged
+//    r is in canvas coordinates
+//---------------------------------------------------------
+
+void Navigator::dataChanged(const QRectF& r)
+      {
+      if (!_score || _previewOnly)
+            return;
+      const QList<Page*>& pages = _score->pages();
+      bool changed = false;
+      for (int i = 0; i < pages.size() && i < thumbnails.size(); ++i) {
+            if (thumbnails[i].valid && pages[i]->abbox().translated(pages[i]->pos()).intersects(r)) {
+                  thumbnails[i].valid = false;
+                  changed = true;
+                  }
+            }
+      if (changed)
+            update();
+      }
+
+//---------------------------------------------------------
+//   renderThumbnail
+//---------------------------------------------------------
+
+void Navigator::renderThumbnail(int pageIdx)
+      {
+      Page* page       = _score->pages()[pageIdx];
+      PageThumbnail& t = thumbnails[pageIdx];
+      const qreal dpr  = devicePixelRatioF();
+      const QSize size = matrix.mapRect(page->bbox()).size().toSize();
+      if (size.isEmpty())
+            return;
+
+      t.pm = QPixmap(size * dpr);
+      t.pm.setDevicePixelRatio(dpr);
+      t.pm.fill(Qt::white);
+      QPainter p(&t.pm);
+      p.setTransform(matrix);
+      for (System* s  : page->systems()) {
+            for (MeasureBase* m : s->measures())
+                  m->scanElements(&p, paintElement, false);
+            }
+      page->scanElements(&p, paintElement, false);
+
+      t.valid   = true;
+      t.tick    = pageTick(page);
+      t.endTick = page->endTick();
+      t.systems = page->systems().size();
+      }
+
+//---------------------------------------------------------
+//   renderPendingThumbnails
+//    render thumbnails from the event loop in small
+//    batches, so scrolling stays responsive while
+//    many pages are invalid
+//---------------------------------------------------------
+
+void Navigator::renderPendingThumbnails()
+      {
+      if (!_score) {
+            pendingPages.clear();
+            return;
+            }
+      QElapsedTimer timer;
+      timer.start();
+      while (!pendingPages.empty() && timer.elapsed() < 20) {
+            int idx = *pendingPages.begin();
+            pendingPages.erase(pendingPages.begin());
+            if (idx < thumbnails.size() && idx < _score->pages().size() && !thumbnails[idx].valid)
+                  renderThumbnail(idx);
+            }
+      if (!pendingPages.empty())
+            renderTimer->start();
+      update();
+      }
+
 //---------------------------------------------------------
 //   paintEvent
+//    composite the page thumbnails, invalid ones are
+//    shown until they are rendered again
 //---------------------------------------------------------
 
 void Navigator::paintEvent(QPaintEvent* ev)
@@ -354,6 +494,8 @@ void Navigator::paintEvent(QPaintEvent* ev)
             return;
       if (_score->pages().size() <= 0)
             return;
+      if (thumbnails.size() != _score->pages().size())
+            thumbnails.resize(_score->pages().size());
 
       // compute optimal size of page number
       QFont font("FreeSans", 4000);
@@ -362,7 +504,6 @@ void Navigator::paintEvent(QPaintEvent* ev)
       qreal factor = (firstPage->width() * 0.5) / fm.width(QString::number(_score->pages().size()));
       font.setPointSizeF(font.pointSizeF() * factor);
 
-      p.setTransform(matrix);
       QRectF fr = matrix.inverted().mapRect(QRectF(r));
       int i = 0;
       for (Page* page : _score->pages()) {
@@ -370,26 +511,33 @@ void Navigator::paintEvent(QPaintEvent* ev)
             if (_previewOnly)
                   pos = QPointF(i * page->width(), 0);
             QRectF pr(page->abbox().translated(pos));
-            if (pr.right() < fr.left())
+            if (pr.right() < fr.left()) {
+                  i++;
                   continue;
+                  }
             if (pr.left() > fr.right())
                   break;
 
-            p.fillRect(pr, Qt::white);
-            p.translate(pos);
-            for (System* s  : page->systems()) {
-                  for (MeasureBase* m : s->measures())
-                        m->scanElements(&p, paintElement, false);
+            PageThumbnail& t = thumbnails[i];
+            QRectF dr(matrix.mapRect(pr));
+            if (t.pm.isNull())
+                  p.fillRect(dr, Qt::white);
+            else
+                  p.drawPixmap(dr, t.pm, QRectF(t.pm.rect()));
+            if (!t.valid) {
+                  pendingPages.insert(i);
+                  renderTimer->start();
                   }
-            page->scanElements(&p, paintElement, false);
+
             if (page->score()->layoutMode() == LayoutMode::PAGE) {
+                  p.setTransform(matrix);
+                  p.translate(pos);
                   p.setFont(font);
                   p.setPen(MScore::layoutBreakColor);
                   p.drawText(page->bbox(), Qt::AlignCenter, QString("%1").arg(page->no() + 1 + _score->pageNumberOffset()));
+                  p.resetTransform();
                   }
-            p.translate(-pos);
             i++;
             }
       }
 }
-
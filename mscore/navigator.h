@@ -20,6 +20,8 @@
 #ifndef __NAVIGATOR_H__
 #define __NAVIGATOR_H__
 
+#include "libmscore/fraction.h"
+
 namespace Ms {
 
 class Score;
@@ -56,6 +58,19 @@ class ViewRect : public QWidget {
       };
 
 
+//---------------------------------------------------------
+//   PageThumbnail
+//    page rendered at navigator scale
+//---------------------------------------------------------
+
+struct PageThumbnail {
+      QPixmap pm;
+      bool valid = false;
+      Fraction tick;          // page contents when rendered
+      Fraction endTick;
+      int systems = 0;
+      };
+
 //---------------------------------------------------------
 //   Navigator
 //---------------------------------------------------------
@@ -72,16 +87,26 @@ class Navigator : public QWidget {
       QTransform matrix;
       bool _previewOnly;
 
+      QVector<PageThumbnail> thumbnails;
+      std::set<int> pendingPages;         // visible pages waiting for a new thumbnail
+      QTimer* renderTimer;
+
       void rescale();
+      void invalidateThumbnails();
+      void renderThumbnail(int pageIdx);
 
       virtual void paintEvent(QPaintEvent*);
       virtual void mousePressEvent(QMouseEvent*);
       virtual void mouseMoveEvent(QMouseEvent*);
       virtual void resizeEvent(QResizeEvent*);
 
+   private slots:
+      void renderPendingThumbnails();
+
    public slots:
       void updateViewRect();
       void layoutChanged();
+      void dataChanged(const QRectF&);
 
    signals:
       void viewRectMoved(const QRectF&);
@@ -0,0 +1,252 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2019 Werner Schweer and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#include <chrono>
+
+#include "nullaudio.h"
+#include "musescore.h"
+#include "seq.h"
+#include "synthesizer/msynthesizer.h"
+#include "libmscore/score.h"
+
+namespace Ms {
+
+extern MasterSynthesizer* synthesizerFactory();
+
+// render time histogram, in percent of the period length
+static const int loadHistogramEdges[] = { 10, 25, 50, 75, 90, 100, 150, 200 };
+
+//---------------------------------------------------------
+//   NullAudio
+//---------------------------------------------------------
+
+NullAudio::NullAudio(Seq* s, int sampleRate, int periodSize)
+   : Driver(s), _sampleRate(sampleRate), _periodSize(periodSize)
+      {
+      _state    = int(Transport::STOP);
+      _quit     = false;
+      _finished = false;
+      }
+
+NullAudio::~NullAudio()
+      {
+      stop();
+      }
+
+//---------------------------------------------------------
+//   init
+//---------------------------------------------------------
+
+bool NullAudio::init(bool)
+      {
+      return _periodSize > 0 && _periodSize <= MasterSynthesizer::MAX_BUFFERSIZE / 2 && _sampleRate > 0;
+      }
+
+//---------------------------------------------------------
+//   start
+//---------------------------------------------------------
+
+bool NullAudio::start(bool)
+      {
+      if (thread.joinable())
+            return true;
+      _quit     = false;
+      _finished = false;
+      renderTimes.clear();
+      _peakVoices = 0;
+      thread = std::thread(&NullAudio::processLoop, this);
+      return true;
+      }
+
+//---------------------------------------------------------
+//   stop
+//---------------------------------------------------------
+
+bool NullAudio::stop()
+      {
+      _quit = true;
+      if (thread.joinable())
+            thread.join();
+      return true;
+      }
+
+//---------------------------------------------------------
+//   startTransport
+//---------------------------------------------------------
+
+void NullAudio::startTransport()
+      {
+      _state = int(Transport::PLAY);
+      }
+
+//---------------------------------------------------------
+//   stopTransport
+//---------------------------------------------------------
+
+void NullAudio::stopTransport()
+      {
+      _state = int(Transport::STOP);
+      }
+
+//---------------------------------------------------------
+//   getState
+//---------------------------------------------------------
+
+Transport NullAudio::getState()
+      {
+      return Transport(int(_state));
+      }
+
+//---------------------------------------------------------
+//   processLoop
+//    audio thread; periods are processed back to back
+//    while playing, the loop ends when playback stops
+//---------------------------------------------------------
+
+void NullAudio::processLoop()
+      {
+      std::vector<float> buffer(_periodSize * 2);
+      bool played = false;
+      while (!_quit) {
+            auto t0 = std::chrono::steady_clock::now();
+            seq->process(_periodSize, buffer.data());
+            auto t1 = std::chrono::steady_clock::now();
+            if (seq->isPlaying()) {
+                  played = true;
+                  renderTimes.push_back(std::chrono::duration<float, std::micro>(t1 - t0).count());
+                  if (seq->synti())
+                        _peakVoices = qMax(_peakVoices, seq->synti()->voiceCount());
+                  }
+            else if (played) {
+                  _finished = true;
+                  break;
+                  }
+            else
+                  std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+      }
+
+//---------------------------------------------------------
+//   report
+//    render time statistics, call after stop()
+//---------------------------------------------------------
+
+QJsonObject NullAudio::report() const
+      {
+      const double deadline = 1e6 * _periodSize / _sampleRate;    // microseconds
+      std::vector<float> times(renderTimes);
+      std::sort(times.begin(), times.end());
+
+      const int nEdges = sizeof(loadHistogramEdges) / sizeof(*loadHistogramEdges);
+      std::vector<int> counts(nEdges + 1, 0);
+      double total = 0.0;
+      int misses   = 0;
+      for (float t : times) {
+            total += t;
+            if (t > deadline)
+                  ++misses;
+            const double load = 100.0 * t / deadline;
+            int i = 0;
+            while (i < nEdges && load > loadHistogramEdges[i])
+                  ++i;
+            ++counts[i];
+            }
+
+      QJsonArray edges;
+      for (int e : loadHistogramEdges)
+            edges.append(e);
+      QJsonArray countList;
+      for (int c : counts)
+            countList.append(c);
+      QJsonObject histogram;
+      histogram["edgesPercent"] = edges;        // counts has one more entry for loads above the last edge
+      histogram["counts"]       = countList;
+
+      auto percentile = [&times](double p) {
+            return times.empty() ? 0.0 : double(times[qMin(times.size() - 1, size_t(p * times.size()))]);
+            };
+      QJsonObject renderTime;
+      renderTime["min"]  = times.empty() ? 0.0 : double(times.front());
+      renderTime["mean"] = times.empty() ? 0.0 : total / times.size();
+      renderTime["p50"]  = percentile(0.5);
+      renderTime["p90"]  = percentile(0.9);
+      renderTime["p99"]  = percentile(0.99);
+      renderTime["max"]  = times.empty() ? 0.0 : double(times.back());
+
+      const double audioTime = double(times.size()) * deadline;
+
+      QJsonObject o;
+      o["sampleRate"]     = _sampleRate;
+      o["periodSize"]     = _periodSize;
+      o["periods"]        = int(times.size());
+      o["deadlineUs"]     = deadline;
+      o["renderTimeUs"]   = renderTime;
+      o["histogram"]      = histogram;
+      o["deadlineMisses"] = misses;
+      o["peakVoices"]     = _peakVoices;
+      o["realtimeFactor"] = total > 0.0 ? audioTime / total : 0.0;
+      return o;
+      }
+
+//---------------------------------------------------------
+//   audioBenchmark
+//    play a score through the null driver and write the
+//    render time statistics as JSON
+//---------------------------------------------------------
+
+bool MuseScore::audioBenchmark(const QString& inFilePath, const QString& outFilePath, int periodSize, int sampleRate)
+      {
+      std::unique_ptr<MasterScore> score(mscore->readScore(inFilePath));
+      if (!score)
+            return false;
+
+      MasterSynthesizer* synth = synthesizerFactory();
+      synth->init();
+      synth->setSampleRate(sampleRate);
+      if (!synth->setState(score->synthesizerState()))
+            synth->init();
+      score->rebuildAndUpdateExpressive(synth->synthesizer("Fluid"));
+      MasterSynthesizer* oldSynti = synti;
+      synti              = synth;           // used by the midi renderer
+      MScore::sampleRate = sampleRate;
+
+      Seq* s = new Seq();
+      s->setMasterSynthesizer(synth);
+      NullAudio* driver = new NullAudio(s, sampleRate, periodSize);
+      s->setDriver(driver);
+      if (!driver->init() || !s->init()) {
+            fprintf(stderr, "audio benchmark: invalid period size %d or sample rate %d\n", periodSize, sampleRate);
+            delete s;
+            synti = oldSynti;
+            delete synth;
+            return false;
+            }
+
+      s->startHeadless(score.get());
+      while (!driver->finished())
+            QThread::msleep(10);
+      driver->stop();
+
+      QJsonObject result = driver->report();
+      result["score"] = inFilePath;
+      delete s;
+      synti = oldSynti;
+      delete synth;
+
+      QFile f(outFilePath);
+      if (!f.open(QIODevice::WriteOnly))
+            return false;
+      f.write(QJsonDocument(result).toJson());
+      return true;
+      }
+
+} // namespace Ms
@@ -0,0 +1,65 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2019 Werner Schweer and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#ifndef __NULLAUDIO_H__
+#define __NULLAUDIO_H__
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "driver.h"
+
+namespace Ms {
+
+class Seq;
+enum class Transport : char;
+
+//---------------------------------------------------------
+//   NullAudio
+//    Audio driver without a device. A thread calls
+//    Seq::process() back to back without waiting for
+//    wall clock time and records how long each period
+//    took to render. Used by --audio-benchmark.
+//---------------------------------------------------------
+
+class NullAudio : public Driver {
+      int _sampleRate;
+      int _periodSize;
+      std::atomic<int> _state;      // Transport
+      std::atomic<bool> _quit;
+      std::atomic<bool> _finished;  // playback started and stopped again
+      std::thread thread;
+
+      std::vector<float> renderTimes; // per period in microseconds
+      int _peakVoices = 0;
+
+      void processLoop();
+
+   public:
+      NullAudio(Seq*, int sampleRate, int periodSize);
+      virtual ~NullAudio();
+      virtual bool init(bool hot = false) override;
+      virtual bool start(bool hotPlug = false) override;
+      virtual bool stop() override;
+      virtual void startTransport() override;
+      virtual void stopTransport() override;
+      virtual Transport getState() override;
+      virtual int sampleRate() const override { return _sampleRate; }
+      virtual int bufferSize() override       { return _periodSize; }
+
+      bool finished() const { return _finished; }
+      QJsonObject report() const;
+      };
+
+} // namespace Ms
+#endif
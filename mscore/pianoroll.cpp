@@ -723,6 +723,18 @@ Element* PianorollEditor::elementNear(QPointF)
 
 void PianorollEditor::updateAll()
       {
+      // remember the range of the command, the command state
+      // is reset before doUpdate() runs
+      CmdState& cs = _score->masterScore()->cmdState();
+      if (cs.layoutRange() && cs.startTick() >= Fraction(0,1)) {
+            int t1 = cs.startTick().ticks();
+            int t2 = cs.endTick().ticks();
+            updateStartTick = updateStartTick == -1 ? t1 : qMin(updateStartTick, t1);
+            updateEndTick   = qMax(updateEndTick, t2);
+            }
+      else
+            updateFullScore = true;
+
       if (updateScheduled)
             return;
 
@@ -737,12 +749,21 @@ void PianorollEditor::updateAll()
 void PianorollEditor::doUpdate()
       {
       updateScheduled = false;
+      const bool full = updateFullScore || updateStartTick == -1;
+      const int startTick = updateStartTick;
+      const int endTick   = updateEndTick;
+      updateStartTick = -1;
+      updateEndTick   = -1;
+      updateFullScore = false;
 
       if (staff && staff->idx() == -1) { // staff removed
             removeScore();
             return;
             }
-      pianoView->updateNotes();
+      if (full)
+            pianoView->updateNotes();
+      else
+            pianoView->updateNotes(startTick, endTick);
       pianoLevels->updateNotes();
       }
 
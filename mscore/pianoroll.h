@@ -68,6 +68,9 @@ class PianorollEditor : public QMainWindow, public MuseScoreView {
       QList<QAction*> actions;
 
       bool updateScheduled = false;
+      int updateStartTick  = -1;          // tick range changed since the last doUpdate()
+      int updateEndTick    = -1;
+      bool updateFullScore = false;
 
       void updateVelocity(Note* note);
       void updateSelection();
@@ -65,6 +65,8 @@ const BarPattern PianoView::barPatterns[] = {
       {"",              {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}}
 };
 
+static const int GRID_BLOCK = 4;    // width of a note grid block in quarter notes
+
 //---------------------------------------------------------
 //   PianoItem
 //---------------------------------------------------------
@@ -171,6 +173,30 @@ bool PianoItem::intersects(int startTick, int endTick, int highPitch, int lowPit
       }
 
 
+//---------------------------------------------------------
+//   tickBounds
+//    return the tick and pitch range covered by all
+//    blocks of this item
+//---------------------------------------------------------
+
+void PianoItem::tickBounds(int& tick1, int& tick2, int& lowPitch, int& highPitch)
+      {
+      QRect r = boundingRectTicks(0);
+      tick1     = qMin(r.left(), r.right());
+      tick2     = qMax(r.left(), r.right());
+      lowPitch  = r.y();
+      highPitch = r.y();
+      if (_pianoView->playEventsView()) {
+            for (NoteEvent& e : _note->playEvents()) {
+                  r = boundingRectTicks(&e);
+                  tick1     = qMin(tick1, qMin(r.left(), r.right()));
+                  tick2     = qMax(tick2, qMax(r.left(), r.right()));
+                  lowPitch  = qMin(lowPitch, r.y());
+                  highPitch = qMax(highPitch, r.y());
+                  }
+            }
+      }
+
 //---------------------------------------------------------
 //   getTweakNoteEvent
 //---------------------------------------------------------
@@ -448,8 +474,8 @@ void PianoView::drawBackground(QPainter* p, const QRectF& r)
             }
 
       //Draw notes
-      for (int i = 0; i < noteList.size(); ++i)
-            noteList[i]->paint(p);
+      for (PianoItem* item : itemsInRange(pixelXToTick(r.x()) - 1, pixelXToTick(r.x() + r.width()) + 1, bmPitch - 1, topPitch + 1))
+            item->paint(p);
 
       //Draw locators
       for (int i = 0; i < 3; ++i) {
@@ -914,19 +940,93 @@ bool PianoView::cutChordRest(ChordRest* e, int track, int cutTick, ChordRest*& c
       }
 
 //---------------------------------------------------------
-//   selectNotes
+//   indexItem
+//    add item to all grid cells covered by its blocks
 //---------------------------------------------------------
 
-PianoItem* PianoView::pickNote(int tick, int pitch)
+void PianoView::indexItem(PianoItem* item)
       {
-      for (int i = 0; i < noteList.size(); ++i) {
-            PianoItem* pi = noteList[i];
+      int tick1, tick2, lowPitch, highPitch;
+      item->tickBounds(tick1, tick2, lowPitch, highPitch);
+
+      const int blockTicks = MScore::division * GRID_BLOCK;
+      int block1 = qMax(tick1, 0) / blockTicks;
+      int block2 = qMax(tick2, 0) / blockTicks;
+      lowPitch   = qBound(0, lowPitch, 127);
+      highPitch  = qBound(0, highPitch, 127);
+      for (int block = block1; block <= block2; ++block) {
+            for (int pitch = lowPitch; pitch <= highPitch; ++pitch)
+                  noteGrid[gridKey(block, pitch)].append(item);
+            }
+      item->setCells(QRect(QPoint(block1, lowPitch), QPoint(block2, highPitch)));
+      gridLastBlock = qMax(gridLastBlock, block2);
+      }
+
+//---------------------------------------------------------
+//   unindexItem
+//    remove item from the grid cells it was added to
+//---------------------------------------------------------
 
-            if (pi->intersects(tick, tick, pitch, pitch))
-                  return pi;
+void PianoView::unindexItem(PianoItem* item)
+      {
+      const QRect& r = item->cells();
+      for (int block = r.left(); block <= r.right(); ++block) {
+            for (int pitch = r.top(); pitch <= r.bottom(); ++pitch) {
+                  auto cell = noteGrid.find(gridKey(block, pitch));
+                  if (cell == noteGrid.end())
+                        continue;
+                  cell->removeOne(item);
+                  if (cell->isEmpty())
+                        noteGrid.erase(cell);
+                  }
             }
+      }
 
-      return 0;
+//---------------------------------------------------------
+//   itemsInRange
+//    return all items intersecting the given tick and
+//    pitch range in note list order
+//---------------------------------------------------------
+
+QList<PianoItem*> PianoView::itemsInRange(int startTick, int endTick, int lowPitch, int highPitch)
+      {
+      QList<PianoItem*> list;
+      if (noteList.empty() || startTick > endTick || lowPitch > highPitch)
+            return list;
+
+      const int blockTicks = MScore::division * GRID_BLOCK;
+      int block1 = qMax(startTick, 0) / blockTicks;
+      int block2 = qMin(qMax(endTick, 0) / blockTicks, gridLastBlock);
+      int pitch1 = qBound(0, lowPitch, 127);
+      int pitch2 = qBound(0, highPitch, 127);
+
+      QSet<PianoItem*> visited;
+      for (int block = block1; block <= block2; ++block) {
+            for (int pitch = pitch1; pitch <= pitch2; ++pitch) {
+                  auto cell = noteGrid.constFind(gridKey(block, pitch));
+                  if (cell == noteGrid.constEnd())
+                        continue;
+                  for (PianoItem* pi : *cell) {
+                        if (visited.contains(pi))
+                              continue;
+                        visited.insert(pi);
+                        if (pi->intersects(startTick, endTick, highPitch, lowPitch))
+                              list.append(pi);
+                        }
+                  }
+            }
+      std::sort(list.begin(), list.end(), [](PianoItem* a, PianoItem* b) { return a->order() < b->order(); });
+      return list;
+      }
+
+//---------------------------------------------------------
+//   pickNote
+//---------------------------------------------------------
+
+PianoItem* PianoView::pickNote(int tick, int pitch)
+      {
+      QList<PianoItem*> list = itemsInRange(tick, tick, pitch, pitch);
+      return list.empty() ? 0 : list.front();
       }
 
 //---------------------------------------------------------
@@ -939,19 +1039,32 @@ void PianoView::selectNotes(int startTick, int endTick, int lowPitch, int highPi
       //score->masterScore()->cmdState().reset();      // DEBUG: should not be necessary
       score->startCmd();
 
-      QList<PianoItem*> oldSel;
-      for (int i = 0; i < noteList.size(); ++i) {
-            PianoItem* pi = noteList[i];
-            if (pi->note()->selected())
-                  oldSel.append(pi);
+      QSet<PianoItem*> oldSel;
+      for (Element* e : score->selection().elements()) {
+            if (e->isNote()) {
+                  PianoItem* pi = noteItems.value(toNote(e));
+                  if (pi)
+                        oldSel.insert(pi);
+                  }
+            }
+      QList<PianoItem*> inBoundsList = itemsInRange(startTick, endTick, lowPitch, highPitch);
+      QSet<PianoItem*> inBoundsSet = QSet<PianoItem*>::fromList(inBoundsList);
+
+      // only items in bounds or previously selected can end up selected
+      QList<PianoItem*> candidates = inBoundsList;
+      if (selType == NoteSelectType::XOR || selType == NoteSelectType::ADD || selType == NoteSelectType::SUBTRACT) {
+            for (PianoItem* pi : oldSel) {
+                  if (!inBoundsSet.contains(pi))
+                        candidates.append(pi);
+                  }
+            std::sort(candidates.begin(), candidates.end(), [](PianoItem* a, PianoItem* b) { return a->order() < b->order(); });
             }
 
       Selection& selection = score->selection();
       selection.deselectAll();
 
-      for (int i = 0; i < noteList.size(); ++i) {
-            PianoItem* pi = noteList[i];
-            bool inBounds = pi->intersects(startTick, endTick, highPitch, lowPitch);
+      for (PianoItem* pi : candidates) {
+            bool inBounds = inBoundsSet.contains(pi);
 
             bool sel;
             switch (selType) {
@@ -1096,16 +1209,52 @@ void PianoView::setStaff(Staff* s, Pos* l)
 
 //---------------------------------------------------------
 //   addChord
+//    append the items of the notes of chrd to items,
+//    reusing the items in oldNoteItems
 //---------------------------------------------------------
 
-void PianoView::addChord(Chord* chrd, int voice)
+void PianoView::addChord(Chord* chrd, int tick, QHash<Note*, PianoItem*>& oldNoteItems, QList<PianoItem*>& items)
       {
       for (Chord* c : chrd->graceNotes())
-            addChord(c, voice);
+            addChord(c, tick, oldNoteItems, items);
       for (Note* note : chrd->notes()) {
             if (note->tieBack())
                   continue;
-            noteList.append(new PianoItem(note, this));
+            PianoItem* pi = oldNoteItems.take(note);
+            if (!pi) {
+                  // the note may have been moved here from outside of
+                  // the updated range
+                  pi = noteItems.take(note);
+                  if (pi) {
+                        unindexItem(pi);
+                        noteList.removeOne(pi);
+                        }
+                  else
+                        pi = new PianoItem(note, this);
+                  }
+            pi->setTick(tick);
+            items.append(pi);
+            }
+      }
+
+//---------------------------------------------------------
+//   addSegments
+//    collect the items of all chords of the staff in
+//    segments from s up to endTick (exclusive, -1 for the
+//    end of the score)
+//---------------------------------------------------------
+
+void PianoView::addSegments(Segment* s, int endTick, QHash<Note*, PianoItem*>& oldNoteItems, QList<PianoItem*>& items)
+      {
+      int staffIdx = _staff->idx();
+      SegmentType st = SegmentType::ChordRest;
+      for (; s && (endTick == -1 || s->tick().ticks() < endTick); s = s->next1(st)) {
+            for (int voice = 0; voice < VOICES; ++voice) {
+                  int track = voice + staffIdx * VOICES;
+                  Element* e = s->element(track);
+                  if (e && e->isChord())
+                        addChord(toChord(e), s->tick().ticks(), oldNoteItems, items);
+                  }
             }
       }
 
@@ -1118,21 +1267,29 @@ void PianoView::updateNotes()
       scene()->blockSignals(true);  // block changeSelection()
       scene()->clearFocus();
       scene()->clear();
-      clearNoteData();
+
+      // keep the items of notes which are still there,
+      // only items of removed notes are deleted
+      QHash<Note*, PianoItem*> oldNoteItems;
+      oldNoteItems.swap(noteItems);
+      noteList.clear();
+      noteGrid.clear();
+      gridLastBlock = -1;
 
       int staffIdx = _staff->idx();
-      if (staffIdx == -1)
+      if (staffIdx == -1) {
+            qDeleteAll(oldNoteItems);
             return;
+            }
 
-      SegmentType st = SegmentType::ChordRest;
-      for (Segment* s = _staff->score()->firstSegment(st); s; s = s->next1(st)) {
-            for (int voice = 0; voice < VOICES; ++voice) {
-                  int track = voice + staffIdx * VOICES;
-                  Element* e = s->element(track);
-                  if (e && e->isChord())
-                        addChord(toChord(e), voice);
-                  }
+      addSegments(_staff->score()->firstSegment(SegmentType::ChordRest), -1, oldNoteItems, noteList);
+      for (int i = 0; i < noteList.size(); ++i) {
+            PianoItem* pi = noteList[i];
+            pi->setOrder(i);
+            noteItems.insert(pi->note(), pi);
+            indexItem(pi);
             }
+      qDeleteAll(oldNoteItems);
       for (int i = 0; i < 3; ++i)
             moveLocator(i);
       scene()->blockSignals(false);
@@ -1142,6 +1299,62 @@ void PianoView::updateNotes()
 
 //---------------------------------------------------------
 //   updateNotes
+//    replace only the items of chords in the measures
+//    around startTick - endTick, the range of the last
+//    command; items outside of it are not touched and
+//    their notes not accessed
+//---------------------------------------------------------
+
+void PianoView::updateNotes(int startTick, int endTick)
+      {
+      Score* score = _staff->score();
+      Measure* m1  = score->tick2measure(Fraction::fromTicks(startTick));
+      Measure* m2  = score->tick2measure(Fraction::fromTicks(endTick));
+      if (_staff->idx() == -1 || !m1 || !m2) {
+            updateNotes();
+            return;
+            }
+      // a measure more on both sides for ties into and out of the range
+      if (m1->prevMeasure())
+            m1 = m1->prevMeasure();
+      if (m2->nextMeasure())
+            m2 = m2->nextMeasure();
+      int tick1 = m1->tick().ticks();
+      int tick2 = m2->nextMeasure() ? m2->endTick().ticks() : -1;
+
+      scene()->blockSignals(true);  // block changeSelection()
+
+      // noteList is sorted by tick
+      auto tickLess = [](PianoItem* pi, int tick) { return pi->tick() < tick; };
+      auto i1 = std::lower_bound(noteList.begin(), noteList.end(), tick1, tickLess);
+      auto i2 = tick2 == -1 ? noteList.end() : std::lower_bound(i1, noteList.end(), tick2, tickLess);
+      QHash<Note*, PianoItem*> oldNoteItems;
+      for (auto i = i1; i != i2; ++i) {
+            unindexItem(*i);
+            noteItems.remove((*i)->note());
+            oldNoteItems.insert((*i)->note(), *i);
+            }
+      noteList.erase(i1, i2);
+
+      QList<PianoItem*> items;
+      addSegments(m1->first(SegmentType::ChordRest), tick2, oldNoteItems, items);
+      // addChord() may have taken items from noteList
+      int pos = int(std::lower_bound(noteList.begin(), noteList.end(), tick1, tickLess) - noteList.begin());
+      for (int i = 0; i < items.size(); ++i) {
+            noteList.insert(pos + i, items[i]);
+            noteItems.insert(items[i]->note(), items[i]);
+            indexItem(items[i]);
+            }
+      for (int i = pos; i < noteList.size(); ++i)
+            noteList[i]->setOrder(i);
+      qDeleteAll(oldNoteItems);
+      scene()->blockSignals(false);
+
+      scene()->update(sceneRect());
+      }
+
+//---------------------------------------------------------
+//   clearNoteData
 //---------------------------------------------------------
 
 void PianoView::clearNoteData()
@@ -1150,6 +1363,9 @@ void PianoView::clearNoteData()
             delete noteList[i];
 
       noteList.clear();
+      noteItems.clear();
+      noteGrid.clear();
+      gridLastBlock = -1;
       }
 
 
@@ -22,6 +22,7 @@ class Staff;
 class Chord;
 class ChordRest;
 class Note;
+class Segment;
 class NoteEvent;
 class PianoView;
 
@@ -51,6 +52,9 @@ struct BarPattern {
 class PianoItem {
       Note* _note;
       PianoView* _pianoView;
+      int _order { 0 };       // position in the note list of the view
+      int _tick  { 0 };       // tick of the chord segment
+      QRect _cells;           // grid cells the item is indexed in, blocks by pitches
       
       void paintNoteBlock(QPainter* painter, NoteEvent* evt);
       QRect boundingRectTicks(NoteEvent* evt);
@@ -63,7 +67,14 @@ class PianoItem {
       Note* note() { return _note; }
       void paint(QPainter* painter);
       bool intersects(int startTick, int endTick, int highPitch, int lowPitch);
-      
+      void tickBounds(int& tick1, int& tick2, int& lowPitch, int& highPitch);
+      int order() const       { return _order; }
+      void setOrder(int val)  { _order = val;  }
+      int tick() const        { return _tick;  }
+      void setTick(int val)   { _tick = val;   }
+      const QRect& cells() const    { return _cells; }
+      void setCells(const QRect& r) { _cells = r;    }
+
       QRect boundingRect();
       
       NoteEvent* getTweakNoteEvent();
@@ -103,10 +114,19 @@ private:
       bool inProgressUndoEvent;
       
       QList<PianoItem*> noteList;
+      QHash<Note*, PianoItem*> noteItems;             // noteList by note, to reuse items in updateNotes()
+      QHash<quint32, QList<PianoItem*>> noteGrid;     // noteList by (tick block, pitch) cell
+      int gridLastBlock { -1 };
+
+      static quint32 gridKey(int block, int pitch) { return (quint32(block) << 7) | quint32(pitch); }
+      void indexItem(PianoItem* item);
+      void unindexItem(PianoItem* item);
+      QList<PianoItem*> itemsInRange(int startTick, int endTick, int lowPitch, int highPitch);
 
       virtual void drawBackground(QPainter* painter, const QRectF& rect);
 
-      void addChord(Chord* chord, int voice);
+      void addChord(Chord* chord, int tick, QHash<Note*, PianoItem*>& oldNoteItems, QList<PianoItem*>& items);
+      void addSegments(Segment* s, int endTick, QHash<Note*, PianoItem*>& oldNoteItems, QList<PianoItem*>& items);
       void updateBoundingSize();
       void clearNoteData();
       void selectNotes(int startTick, int endTick, int lowPitch, int highPitch, NoteSelectType selType);
@@ -136,6 +156,7 @@ private:
    public slots:
       void moveLocator(int);
       void updateNotes();
+      void updateNotes(int startTick, int endTick);
       void setXZoom(int);
       void setTuplet(int);
       void setSubdiv(int);
@@ -103,6 +103,7 @@ void Preferences::init(bool storeInMemoryOnly)
             {PREF_APP_STARTUP_SESSIONSTART,                        new EnumPreference(QVariant::fromValue(SessionStart::SCORE), false)},
             {PREF_APP_STARTUP_STARTSCORE,                          new StringPreference(":/data/My_First_Score.mscx", false)},
             {PREF_UI_APP_STARTUP_SHOWTOURS,                        new BoolPreference(true)},
+            {PREF_APP_UNDO_MEMORYLIMIT,                            new IntPreference(512, false)},
             {PREF_APP_WORKSPACE,                                   new StringPreference("Basic", false)},
             {PREF_EXPORT_AUDIO_NORMALIZE,                          new BoolPreference(true)},
             {PREF_EXPORT_AUDIO_SAMPLERATE,                         new IntPreference(44100, false)},
@@ -145,6 +146,9 @@ void Preferences::init(bool storeInMemoryOnly)
             {PREF_IO_PORTMIDI_OUTPUTDEVICE,                        new StringPreference("")},
             {PREF_IO_PORTMIDI_OUTPUTLATENCYMILLISECONDS,           new IntPreference(0)},
             {PREF_IO_PULSEAUDIO_USEPULSEAUDIO,                     new BoolPreference(defaultUsePulseAudio, false)},
+            {PREF_IO_ZERBERUS_DISKSTREAMING,                       new BoolPreference(false)},
+            {PREF_IO_ZERBERUS_PRELOADMS,                           new IntPreference(500 /* ms */)},
+            {PREF_IO_ZERBERUS_SAMPLECACHEMB,                       new IntPreference(4096 /* MB */)},
             {PREF_SCORE_CHORD_PLAYONADDNOTE,                       new BoolPreference(true, false)},
             {PREF_SCORE_MAGNIFICATION,                             new DoublePreference(1.0, false)},
             {PREF_SCORE_NOTE_PLAYONCLICK,                          new BoolPreference(true, false)},
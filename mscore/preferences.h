@@ -99,6 +99,7 @@ enum class MusicxmlExportBreaks : char {
 #define PREF_APP_STARTUP_FIRSTSTART                         "application/startup/firstStart"
 #define PREF_APP_STARTUP_SESSIONSTART                       "application/startup/sessionStart"
 #define PREF_APP_STARTUP_STARTSCORE                         "application/startup/startScore"
+#define PREF_APP_UNDO_MEMORYLIMIT                           "application/undo/memoryLimit"
 #define PREF_APP_WORKSPACE                                  "application/workspace"
 #define PREF_EXPORT_AUDIO_NORMALIZE                         "export/audio/normalize"
 #define PREF_EXPORT_AUDIO_SAMPLERATE                        "export/audio/sampleRate"
@@ -142,6 +143,9 @@ enum class MusicxmlExportBreaks : char {
 #define PREF_IO_PORTMIDI_OUTPUTDEVICE                       "io/portMidi/outputDevice"
 #define PREF_IO_PORTMIDI_OUTPUTLATENCYMILLISECONDS          "io/portMidi/outputLatencyMilliseconds"
 #define PREF_IO_PULSEAUDIO_USEPULSEAUDIO                    "io/pulseAudio/usePulseAudio"
+#define PREF_IO_ZERBERUS_DISKSTREAMING                      "io/zerberus/diskStreaming"
+#define PREF_IO_ZERBERUS_PRELOADMS                          "io/zerberus/preloadMs"
+#define PREF_IO_ZERBERUS_SAMPLECACHEMB                      "io/zerberus/sampleCacheMB"
 #define PREF_SCORE_CHORD_PLAYONADDNOTE                      "score/chord/playOnAddNote"
 #define PREF_SCORE_MAGNIFICATION                            "score/magnification"
 #define PREF_SCORE_NOTE_PLAYONCLICK                         "score/note/playOnClick"
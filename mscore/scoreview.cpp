@@ -22,6 +22,7 @@
 #include "measureproperties.h"
 #include "musescore.h"
 #include "navigator.h"
+#include "timeline.h"
 #include "preferences.h"
 #include "scoretab.h"
 #include "seq.h"
@@ -211,6 +212,7 @@ void ScoreView::setScore(Score* s)
             }
 
       _score = s;
+      invalidateTiles();
       if (_score) {
             if (_score->isMaster()) {
                   MasterScore* ms = static_cast<MasterScore*>(s);
@@ -494,7 +496,7 @@ void ScoreView::setBackground(QPixmap* pm)
       {
       delete _bgPixmap;
       _bgPixmap = pm;
-      update();
+      updateAll();
       }
 
 void ScoreView::setBackground(const QColor& color)
@@ -502,7 +504,7 @@ void ScoreView::setBackground(const QColor& color)
       delete _bgPixmap;
       _bgPixmap = 0;
       _bgColor = color;
-      update();
+      updateAll();
       }
 
 //---------------------------------------------------------
@@ -513,7 +515,7 @@ void ScoreView::setForeground(QPixmap* pm)
       {
       delete _fgPixmap;
       _fgPixmap = pm;
-      update();
+      updateAll();
       }
 
 void ScoreView::setForeground(const QColor& color)
@@ -521,7 +523,7 @@ void ScoreView::setForeground(const QColor& color)
       delete _fgPixmap;
       _fgPixmap = 0;
       _fgColor = color;
-      update();
+      updateAll();
       }
 
 //---------------------------------------------------------
@@ -530,7 +532,11 @@ void ScoreView::setForeground(const QColor& color)
 
 void ScoreView::dataChanged(const QRectF& r)
       {
+      invalidateTiles(r);
       update(_matrix.mapRect(r).toRect());  // generate paint event
+      Navigator* nav = mscore->navigator();
+      if (nav && nav->score() == _score)
+            nav->dataChanged(r);
       }
 
 //---------------------------------------------------------
@@ -1063,12 +1069,15 @@ void ScoreView::drawElements(QPainter& painter, QList<Element*>& el, Element* ed
       }
 
 //---------------------------------------------------------
-//   paint
+//   drawCanvas
+//    draw the score into rectangle r (widget coordinates)
+//    of a paint device placed at origin
 //---------------------------------------------------------
 
-void ScoreView::paint(const QRect& r, QPainter& p)
+void ScoreView::drawCanvas(QPainter& p, const QRect& r, const QPoint& origin, Element* editModeElement, Element* editElement)
       {
-      p.save();
+      const QTransform toDevice(QTransform::fromTranslate(-origin.x(), -origin.y()));
+      p.setTransform(toDevice);
       if (_fgPixmap == 0 || _fgPixmap->isNull())
             p.fillRect(r, _fgColor);
       else {
@@ -1076,38 +1085,11 @@ void ScoreView::paint(const QRect& r, QPainter& p)
                - QPoint(lrint(_matrix.dx()), lrint(_matrix.dy())));
             }
 
-      p.setTransform(_matrix);
+      p.setTransform(_matrix * toDevice);
       QRectF fr = imatrix.mapRect(QRectF(r));
 
-      Element* editElement = 0;
-      Element* lassoToDraw = 0;
-      if (editData.element) {
-            switch (state) {
-                  case ViewState::NORMAL:
-                  case ViewState::DRAG:
-                  case ViewState::DRAG_OBJECT:
-                  case ViewState::LASSO:
-                  case ViewState::NOTE_ENTRY:
-                  case ViewState::PLAY:
-                  case ViewState::ENTRY_PLAY:
-                        break;
-                  case ViewState::EDIT:
-                  case ViewState::DRAG_EDIT:
-                  case ViewState::FOTO:
-                  case ViewState::FOTO_DRAG:
-                  case ViewState::FOTO_DRAG_EDIT:
-                  case ViewState::FOTO_DRAG_OBJECT:
-                  case ViewState::FOTO_LASSO:
-                        if (editData.element->_name() == "Lasso") // There is no isLasso() method
-                              lassoToDraw = editData.element;
-                        else
-                              editData.element->drawEditMode(&p, editData);
-
-                        if (editData.element->isHarmony())
-                              editElement = editData.element;     // do not call paint() method
-                        break;
-                  }
-            }
+      if (editModeElement)
+            editModeElement->drawEditMode(&p, editData);
 
       QRegion r1(r);
       if ((_score->layoutMode() == LayoutMode::LINE) || (_score->layoutMode() == LayoutMode::SYSTEM)) {
@@ -1202,6 +1184,196 @@ void ScoreView::paint(const QRect& r, QPainter& p)
                   r1 -= _matrix.mapRect(pr).toAlignedRect();
                   }
             }
+
+      if (_score->layoutMode() != LayoutMode::LINE && _score->layoutMode() != LayoutMode::SYSTEM && !r1.isEmpty()) {
+            p.setTransform(toDevice);
+            p.setClipRegion(r1);  // only background
+            if (_bgPixmap == 0 || _bgPixmap->isNull())
+                  p.fillRect(r, _bgColor);
+            else
+                  p.drawTiledPixmap(r, *_bgPixmap, r.topLeft() - QPoint(_matrix.m31(), _matrix.m32()));
+            p.setClipping(false);
+            }
+      }
+
+//---------------------------------------------------------
+//   tileCacheEnabled
+//    the score is drawn from cached tiles unless drawing
+//    depends on view state that is not tracked by
+//    dataChanged()
+//---------------------------------------------------------
+
+bool ScoreView::tileCacheEnabled() const
+      {
+      if (_score->printing())
+            return false;
+#ifndef NDEBUG
+      if (MScore::showBoundingRect)
+            return false;
+#endif
+      return true;
+      }
+
+//---------------------------------------------------------
+//   tileIndex
+//    tile row or column containing v
+//---------------------------------------------------------
+
+static const int tileSize = 256;
+
+static inline int tileIndex(qreal v)
+      {
+      return int(floor(v / tileSize));
+      }
+
+//---------------------------------------------------------
+//   paintTiles
+//    draw rectangle r from the tile cache, missing tiles
+//    are rendered in one pass and then split up
+//---------------------------------------------------------
+
+void ScoreView::paintTiles(QPainter& p, const QRect& r)
+      {
+      const qreal dx  = floor(_matrix.dx());
+      const qreal dy  = floor(_matrix.dy());
+      const qreal dpr = devicePixelRatioF();
+      const QPointF phase(_matrix.dx() - dx, _matrix.dy() - dy);
+      if (_matrix.m11() != _tileMag || phase != _tilePhase || dpr != _tileDpr) {
+            _tiles.clear();
+            _tileMag   = _matrix.m11();
+            _tilePhase = phase;
+            _tileDpr   = dpr;
+            }
+      // keep about two screens worth of tiles
+      const int visibleTiles = (width() / tileSize + 2) * (height() / tileSize + 2);
+      _tiles.setMaxCost(2 * visibleTiles);
+
+      const QPoint offset(int(dx), int(dy));
+      const QRect sr(r.translated(-offset));
+      const int col1 = tileIndex(sr.left());
+      const int col2 = tileIndex(sr.right());
+      const int row1 = tileIndex(sr.top());
+      const int row2 = tileIndex(sr.bottom());
+
+      auto key = [](int col, int row) {
+            return (quint64(quint32(col)) << 32) | quint32(row);
+            };
+      auto tileRect = [offset](int col, int row) {
+            return QRect(col * tileSize + offset.x(), row * tileSize + offset.y(), tileSize, tileSize);
+            };
+
+      QRect missing;
+      for (int row = row1; row <= row2; ++row) {
+            for (int col = col1; col <= col2; ++col) {
+                  if (!_tiles.contains(key(col, row)))
+                        missing |= tileRect(col, row);
+                  }
+            }
+      if (!missing.isEmpty()) {
+            QPixmap pm(missing.size() * dpr);
+            pm.setDevicePixelRatio(dpr);
+            QPainter tp(&pm);
+            tp.setRenderHint(QPainter::Antialiasing, preferences.getBool(PREF_UI_CANVAS_MISC_ANTIALIASEDDRAWING));
+            tp.setRenderHint(QPainter::TextAntialiasing, true);
+            drawCanvas(tp, missing, missing.topLeft(), 0, 0);
+            tp.end();
+            for (int row = row1; row <= row2; ++row) {
+                  for (int col = col1; col <= col2; ++col) {
+                        QRect tr(tileRect(col, row));
+                        if (!missing.contains(tr) || _tiles.contains(key(col, row)))
+                              continue;
+                        QRect src((tr.topLeft() - missing.topLeft()) * dpr, tr.size() * dpr);
+                        QPixmap* tile = new QPixmap(pm.copy(src));
+                        tile->setDevicePixelRatio(dpr);
+                        _tiles.insert(key(col, row), tile);
+                        }
+                  }
+            }
+
+      p.setTransform(QTransform());
+      for (int row = row1; row <= row2; ++row) {
+            for (int col = col1; col <= col2; ++col) {
+                  QRect tr(tileRect(col, row));
+                  QRect ir(tr & r);
+                  const QPixmap* tile = _tiles.object(key(col, row));
+                  if (!tile || ir.isEmpty())
+                        continue;
+                  QRectF src(QPointF(ir.topLeft() - tr.topLeft()) * dpr, QSizeF(ir.size()) * dpr);
+                  p.drawPixmap(QRectF(ir), *tile, src);
+                  }
+            }
+      }
+
+//---------------------------------------------------------
+//   invalidateTiles
+//    r is in canvas coordinates
+//---------------------------------------------------------
+
+void ScoreView::invalidateTiles(const QRectF& r)
+      {
+      if (_tiles.isEmpty() || r.isEmpty())
+            return;
+      // one pixel more for antialiasing
+      QRectF sr(QTransform::fromScale(_tileMag, _tileMag).mapRect(r).translated(_tilePhase).adjusted(-1, -1, 1, 1));
+      const int col1 = tileIndex(sr.left());
+      const int col2 = tileIndex(sr.right());
+      const int row1 = tileIndex(sr.top());
+      const int row2 = tileIndex(sr.bottom());
+      for (quint64 k : _tiles.keys()) {
+            int col = int(quint32(k >> 32));
+            int row = int(quint32(k));
+            if (col >= col1 && col <= col2 && row >= row1 && row <= row2)
+                  _tiles.remove(k);
+            }
+      }
+
+//---------------------------------------------------------
+//   paint
+//---------------------------------------------------------
+
+void ScoreView::paint(const QRect& r, QPainter& p)
+      {
+      p.save();
+
+      Element* editModeElement = 0;
+      Element* editElement = 0;
+      Element* lassoToDraw = 0;
+      if (editData.element) {
+            switch (state) {
+                  case ViewState::NORMAL:
+                  case ViewState::DRAG:
+                  case ViewState::DRAG_OBJECT:
+                  case ViewState::LASSO:
+                  case ViewState::NOTE_ENTRY:
+                  case ViewState::PLAY:
+                  case ViewState::ENTRY_PLAY:
+                        break;
+                  case ViewState::EDIT:
+                  case ViewState::DRAG_EDIT:
+                  case ViewState::FOTO:
+                  case ViewState::FOTO_DRAG:
+                  case ViewState::FOTO_DRAG_EDIT:
+                  case ViewState::FOTO_DRAG_OBJECT:
+                  case ViewState::FOTO_LASSO:
+                        if (editData.element->_name() == "Lasso") // There is no isLasso() method
+                              lassoToDraw = editData.element;
+                        else
+                              editModeElement = editData.element;
+
+                        if (editData.element->isHarmony())
+                              editElement = editData.element;     // do not call paint() method
+                        break;
+                  }
+            }
+
+      // edit mode decorations are drawn below the score, so
+      // they cannot be combined with cached tiles
+      if (editModeElement || !tileCacheEnabled())
+            drawCanvas(p, r, QPoint(), editModeElement, editElement);
+      else
+            paintTiles(p, r);
+
+      p.setTransform(_matrix);
       if (dropRectangle.isValid())
             p.fillRect(dropRectangle, QColor(80, 0, 0, 80));
 
@@ -1328,14 +1500,6 @@ void ScoreView::paint(const QRect& r, QPainter& p)
       if (lassoToDraw)
             lassoToDraw->drawEditMode(&p, editData);
 
-      p.setMatrixEnabled(false);
-      if (_score->layoutMode() != LayoutMode::LINE && _score->layoutMode() != LayoutMode::SYSTEM && !r1.isEmpty()) {
-            p.setClipRegion(r1);  // only background
-            if (_bgPixmap == 0 || _bgPixmap->isNull())
-                  p.fillRect(r, _bgColor);
-            else
-                  p.drawTiledPixmap(r, *_bgPixmap, r.topLeft() - QPoint(_matrix.m31(), _matrix.m32()));
-            }
       p.restore();
       }
 
@@ -1622,8 +1786,7 @@ void ScoreView::normalCopy()
             return;
       QString mimeType = _score->selection().mimeType();
       if (!mimeType.isEmpty()) {
-            QMimeData* mimeData = new QMimeData;
-            mimeData->setData(mimeType, _score->selection().mimeData());
+            QMimeData* mimeData = _score->selection().createMimeData();
             if (MScore::debugMode)
                   qDebug("cmd copy: <%s>", mimeData->data(mimeType).data());
             QApplication::clipboard()->setMimeData(mimeData);
@@ -1688,12 +1851,16 @@ void ScoreView::normalSwap()
       if (mimeType == mimeStaffListFormat) { // determine size of clipboard selection
             Fraction tickLen = Fraction(0,1);
             int staves = 0;
-            QByteArray d(ms->data(mimeStaffListFormat));
-            XmlReader e(d);
-            e.readNextStartElement();
-            if (e.name() == "StaffList") {
-                  tickLen = Fraction::fromTicks(e.intAttribute("len", 0));
-                  staves  = e.intAttribute("staves", 0);
+            XmlTokens tokens;
+            std::unique_ptr<XmlReader> e;
+            if (ms->hasFormat(mimeStaffListBinaryFormat) && tokens.fromByteArray(ms->data(mimeStaffListBinaryFormat)))
+                  e.reset(new XmlReader(&tokens));
+            else
+                  e.reset(new XmlReader(ms->data(mimeStaffListFormat)));
+            e->readNextStartElement();
+            if (e->name() == "StaffList") {
+                  tickLen = Fraction::fromTicks(e->intAttribute("len", 0));
+                  staves  = e->intAttribute("staves", 0);
                   }
             if (tickLen > Fraction(0,1)) { // attempt to extend selection to match clipboard size
                   Segment* seg = _score->selection().startSegment();
@@ -1715,12 +1882,11 @@ void ScoreView::normalSwap()
                   ms = QApplication::clipboard()->mimeData();
                   }
             }
-      QByteArray d(_score->selection().mimeData());
-      if (this->normalPaste()) {
-            QMimeData* mimeData = new QMimeData;
-            mimeData->setData(mimeType, d);
+      QMimeData* mimeData = _score->selection().createMimeData();
+      if (this->normalPaste())
             QApplication::clipboard()->setMimeData(mimeData);
-            }
+      else
+            delete mimeData;
       }
 
 //---------------------------------------------------------
@@ -3449,7 +3615,7 @@ void ScoreView::addSlur(const Slur* slurTemplate)
             if (!el.empty()) {
                   el.front()->setSelected(false);
                   // Now make sure that the slur segment is redrawn so that it does not *look* selected
-                  update();
+                  updateAll();
                   }
             is.setSlur(nullptr);
             return;
@@ -4503,6 +4669,8 @@ void ScoreView::layoutChanged()
       {
       if (mscore->navigator())
             mscore->navigator()->layoutChanged();
+      if (mscore->timeline() && mscore->timeline()->score() == _score)
+            mscore->timeline()->layoutChanged();
       _curLoopIn->move(_score->pos(POS::LEFT));
       Measure* lm = _score->lastMeasure();
       if (lm && _score->pos(POS::RIGHT) > lm->endTick())
@@ -145,8 +145,18 @@ class ScoreView : public QWidget, public MuseScoreView {
 
       bool _blockShowEdit = false;
 
+      // rendered score in tiles of scaled canvas space; valid for
+      // one magnification, subpixel offset and device pixel ratio
+      QCache<quint64, QPixmap> _tiles;
+      qreal _tileMag   { 0.0 };
+      QPointF _tilePhase;
+      qreal _tileDpr   { 0.0 };
+
       virtual void paintEvent(QPaintEvent*);
       void paint(const QRect&, QPainter&);
+      void drawCanvas(QPainter&, const QRect&, const QPoint& origin, Element* editModeElement, Element* editElement);
+      bool tileCacheEnabled() const;
+      void paintTiles(QPainter&, const QRect&);
 
       void objectPopup(const QPoint&, Element*);
       void measurePopup(QContextMenuEvent* ev, Measure*);
@@ -396,7 +406,9 @@ class ScoreView : public QWidget, public MuseScoreView {
 
       virtual void layoutChanged();
       virtual void dataChanged(const QRectF&);
-      virtual void updateAll()    { update(); }
+      virtual void updateAll()    { invalidateTiles(); update(); }
+      void invalidateTiles()      { _tiles.clear(); }
+      void invalidateTiles(const QRectF&);
       virtual void adjustCanvasPosition(const Element* el, bool playBack, int staff = -1) override;
       virtual void setCursor(const QCursor& c) { QWidget::setCursor(c); }
       virtual QCursor cursor() const { return QWidget::cursor(); }
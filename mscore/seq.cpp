@@ -335,6 +335,38 @@ void Seq::start()
       _driver->startTransport();
       }
 
+//---------------------------------------------------------
+//   startHeadless
+//    play score without a ScoreView, used by the audio
+//    benchmark; all events are rendered in advance as a
+//    driver without real time pacing would outrun the
+//    background rendering
+//---------------------------------------------------------
+
+void Seq::startHeadless(MasterScore* score)
+      {
+      cv = 0;
+      cs = score;
+      midi = MidiRenderer(cs);
+      midi.setMinChunkSize(10);
+      playlistChanged = true;
+      _synti->reset();
+      initInstruments();
+
+      collectEvents(0);
+      mutex.lock();
+      for (;;) {
+            const MidiRenderer::Chunk chunk = midi.getChunkAt(renderEventsStatus.occupiedRangeEnd(0));
+            if (!chunk)
+                  break;
+            renderChunk(chunk, &events);
+            }
+      updateEventsEnd();
+      mutex.unlock();
+      setPos(0);
+      _driver->startTransport();
+      }
+
 //---------------------------------------------------------
 //   stop
 //    called from gui thread
@@ -1618,6 +1650,7 @@ void Seq::heartBeatTimeout()
       if (piano && piano->isVisible())
             piano->setPlaybackNotes(markedNotes);
 
+      cv->invalidateTiles(r);
       cv->update(cv->toPhysical(r));
       }
 
@@ -0,0 +1,141 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2019 Werner Schweer and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#include "startupcache.h"
+#include "musescore.h"
+#include "config.h"
+
+namespace Ms {
+
+extern QString revision;
+
+static const quint32 STARTUP_CACHE_MAGIC = 0x4d534331;     // "MSC1"
+
+bool StartupProfile::_enabled = false;
+QElapsedTimer StartupProfile::_timer;
+qint64 StartupProfile::_last = 0;
+QList<QPair<QString, qint64>> StartupProfile::_phases;
+
+//---------------------------------------------------------
+//   StartupCache
+//    the key covers the build, the ui language (cached
+//    data may contain translated strings) and path, size
+//    and modification time of every source file
+//---------------------------------------------------------
+
+StartupCache::StartupCache(const QString& name, const QStringList& sources)
+      {
+      _path = dataPath + "/cache/" + name + ".bin";
+
+      QCryptographicHash hash(QCryptographicHash::Sha1);
+      hash.addData(QByteArray(VERSION));
+      hash.addData(revision.toUtf8());
+      hash.addData(QLocale().name().toUtf8());
+      for (const QString& s : sources) {
+            QFileInfo fi(s);
+            hash.addData(fi.absoluteFilePath().toUtf8());
+            if (fi.exists())
+                  hash.addData(QByteArray::number(fi.size()) + ":" + QByteArray::number(fi.lastModified().toMSecsSinceEpoch()));
+            }
+      _key = hash.result();
+      }
+
+//---------------------------------------------------------
+//   read
+//    return false if there is no valid cache or the
+//    reader fails
+//---------------------------------------------------------
+
+bool StartupCache::read(std::function<bool(QDataStream&)> reader) const
+      {
+      QFile f(_path);
+      if (!f.open(QIODevice::ReadOnly))
+            return false;
+      QDataStream s(&f);
+      s.setVersion(QDataStream::Qt_5_6);
+      quint32 magic;
+      QByteArray key;
+      s >> magic >> key;
+      if (s.status() != QDataStream::Ok || magic != STARTUP_CACHE_MAGIC || key != _key)
+            return false;
+      if (!reader(s) || s.status() != QDataStream::Ok) {
+            qDebug("startup cache <%s> is damaged", qPrintable(_path));
+            return false;
+            }
+      return true;
+      }
+
+//---------------------------------------------------------
+//   write
+//---------------------------------------------------------
+
+bool StartupCache::write(std::function<bool(QDataStream&)> writer) const
+      {
+      QDir().mkpath(QFileInfo(_path).absolutePath());
+      QSaveFile f(_path);
+      if (!f.open(QIODevice::WriteOnly)) {
+            qDebug("cannot write startup cache <%s>", qPrintable(_path));
+            return false;
+            }
+      QDataStream s(&f);
+      s.setVersion(QDataStream::Qt_5_6);
+      s << STARTUP_CACHE_MAGIC << _key;
+      if (!writer(s) || s.status() != QDataStream::Ok) {
+            f.cancelWriting();
+            return false;
+            }
+      return f.commit();
+      }
+
+//---------------------------------------------------------
+//   start
+//---------------------------------------------------------
+
+void StartupProfile::start()
+      {
+      _enabled = true;
+      _timer.start();
+      _last = 0;
+      }
+
+//---------------------------------------------------------
+//   mark
+//    end of a startup phase, the phase took the time
+//    since the previous mark
+//---------------------------------------------------------
+
+void StartupProfile::mark(const QString& phase)
+      {
+      if (!_enabled)
+            return;
+      const qint64 now = _timer.nsecsElapsed();
+      _phases.append(qMakePair(phase, now - _last));
+      _last = now;
+      }
+
+//---------------------------------------------------------
+//   report
+//---------------------------------------------------------
+
+void StartupProfile::report()
+      {
+      if (!_enabled)
+            return;
+      fprintf(stderr, "startup profile:\n");
+      for (const auto& p : _phases)
+            fprintf(stderr, "  %-36s %8.1f ms\n", qPrintable(p.first), p.second / 1000000.0);
+      fprintf(stderr, "  %-36s %8.1f ms\n", "total", _last / 1000000.0);
+      _phases.clear();
+      _enabled = false;
+      }
+
+} // namespace Ms
@@ -0,0 +1,57 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2019 Werner Schweer and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#ifndef __STARTUPCACHE_H__
+#define __STARTUPCACHE_H__
+
+namespace Ms {
+
+//---------------------------------------------------------
+//   StartupCache
+//    binary copy of data parsed at startup, stored in
+//    dataPath/cache; it is valid as long as the build and
+//    the modification times of all source files are the
+//    same as when the cache was written
+//---------------------------------------------------------
+
+class StartupCache {
+      QString _path;
+      QByteArray _key;
+
+   public:
+      StartupCache(const QString& name, const QStringList& sources);
+
+      bool read(std::function<bool(QDataStream&)> reader) const;
+      bool write(std::function<bool(QDataStream&)> writer) const;
+      };
+
+//---------------------------------------------------------
+//   StartupProfile
+//    timing report of the startup phases, enabled with
+//    --startup-profile
+//---------------------------------------------------------
+
+class StartupProfile {
+      static bool _enabled;
+      static QElapsedTimer _timer;
+      static qint64 _last;
+      static QList<QPair<QString, qint64>> _phases;
+
+   public:
+      static void start();
+      static bool enabled()   { return _enabled; }
+      static void mark(const QString& phase);
+      static void report();
+      };
+
+} // namespace Ms
+#endif
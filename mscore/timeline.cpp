@@ -460,6 +460,73 @@ void TRowLabels::resizeEvent(QResizeEvent*)
       updateLabels(labels, 20);
       }
 
+//---------------------------------------------------------
+//   highlightItem
+//    Set the brush of a selected item, remembering the old
+//    one to be restored by the next drawSelection()
+//---------------------------------------------------------
+
+void Timeline::highlightItem(QGraphicsRectItem* item, const QColor& color)
+      {
+      selected_cells.emplace_back(item, item->brush());
+      item->setBrush(QBrush(color));
+      }
+
+//---------------------------------------------------------
+//   removeHighlight
+//    Undo the highlighting of the last drawSelection(), in
+//    reverse order as an item may have been highlighted
+//    more than once
+//---------------------------------------------------------
+
+void Timeline::removeHighlight()
+      {
+      for (auto it = selected_cells.rbegin(); it != selected_cells.rend(); ++it)
+            it->first->setBrush(it->second);
+      selected_cells.clear();
+      if (selection_item) {
+            scene()->removeItem(selection_item);
+            delete selection_item;
+            selection_item = nullptr;
+            }
+      }
+
+//---------------------------------------------------------
+//   clearSelectionItems
+//    Forget the selection items, to be called when the
+//    scene is cleared
+//---------------------------------------------------------
+
+void Timeline::clearSelectionItems()
+      {
+      selected_cells.clear();
+      selection_item = nullptr;
+      }
+
+//---------------------------------------------------------
+//   clearHover
+//---------------------------------------------------------
+
+void Timeline::clearHover()
+      {
+      QGraphicsItem* hovered_item = std::get<0>(old_hover_info);
+      if (!hovered_item)
+            return;
+      QGraphicsItem* pair_item = static_cast<QGraphicsItem*>(hovered_item->data(5).value<void*>());
+      hovered_item->setZValue(std::get<1>(old_hover_info));
+      QGraphicsRectItem* graphics_rect_item1 = qgraphicsitem_cast<QGraphicsRectItem*>(hovered_item);
+      if (graphics_rect_item1)
+            graphics_rect_item1->setBrush(QBrush(std::get<2>(old_hover_info)));
+      if (pair_item) {
+            pair_item->setZValue(std::get<1>(old_hover_info));
+            QGraphicsRectItem* graphics_rect_item2 = qgraphicsitem_cast<QGraphicsRectItem*>(pair_item);
+            if (graphics_rect_item2)
+                  graphics_rect_item2->setBrush(QBrush(std::get<2>(old_hover_info)));
+            }
+      std::get<0>(old_hover_info) = nullptr;
+      std::get<1>(old_hover_info) = -1;
+      }
+
 //---------------------------------------------------------
 //   mousePressEvent
 //---------------------------------------------------------
@@ -868,9 +935,15 @@ void Timeline::drawGrid(int global_rows, int global_cols)
       {
       scene()->clear();
       meta_rows.clear();
+      clearSelectionItems();
+      resetUpdateRange();
+
+      grid_rows  = global_rows;
+      grid_cols  = global_cols;
+      grid_cells.clear();
+      meta_columns.clear();
 
       if (global_rows == 0 || global_cols == 0) return;
-      int stagger = 0;
       unsigned int num_metas = nmetas();
       setMinimumHeight(grid_height * (num_metas + 1) + 5 + horizontalScrollBar()->height());
       setMinimumWidth(grid_width * 3);
@@ -878,7 +951,13 @@ void Timeline::drawGrid(int global_rows, int global_cols)
 
       //Draw grid
       Measure* curr_measure = _score->firstMeasure();
-      QList<Part*> part_list = getParts();
+
+      //Part names are the same for all cells of a row
+      QString translate_measure = tr("Measure");
+      QChar initial_letter = translate_measure[0];
+      std::vector<QString> part_names = partNames(global_rows);
+
+      grid_cells.reserve(global_rows * global_cols);
       for (int col = 0; col < global_cols; col++) {
             for (int row = 0; row < global_rows; row++) {
                   QGraphicsRectItem* graphics_rect_item = new QGraphicsRectItem(col * grid_width,
@@ -886,24 +965,11 @@ void Timeline::drawGrid(int global_rows, int global_cols)
                                                                                 grid_width,
                                                                                 grid_height);
 
-                  setMetaData(graphics_rect_item, row, ElementType::INVALID, curr_measure, false, 0);
-
-                  QString translate_measure = tr("Measure");
-                  QChar initial_letter = translate_measure[0];
-                  QTextDocument doc;
-                  QString part_name = "";
-                  if (part_list.size() > row) {
-                        doc.setHtml(part_list.at(row)->longName());
-                        part_name = doc.toPlainText();
-                        }
-                  if (part_name.isEmpty() && part_list.size() > row)
-                        part_name = part_list.at(row)->instrumentName();
-
-                  graphics_rect_item->setToolTip(initial_letter + QString(" ") + QString::number(curr_measure->no() + 1) + QString(", ") + part_name);
+                  setCell(graphics_rect_item, row, curr_measure, initial_letter, part_names[row]);
                   graphics_rect_item->setPen(QPen(QColor(Qt::lightGray)));
-                  graphics_rect_item->setBrush(QBrush(colorBox(graphics_rect_item)));
                   graphics_rect_item->setZValue(-3);
                   scene()->addItem(graphics_rect_item);
+                  grid_cells.push_back(graphics_rect_item);
                   }
 
             curr_measure = curr_measure->nextMeasure();
@@ -936,7 +1002,56 @@ void Timeline::drawGrid(int global_rows, int global_cols)
             meta_rows.push_back(pair_graphics_int_meta);
             }
 
+      meta_columns.resize(global_cols);
       int x_pos = 0;
+      for (Measure* cm = _score->firstMeasure(); cm; cm = cm->nextMeasure()) {
+            drawMetas(cm, x_pos);
+            x_pos += grid_width;
+            }
+      drawSelection();
+      }
+
+//---------------------------------------------------------
+//   partNames
+//    Part names for the tooltips of the grid rows
+//---------------------------------------------------------
+
+std::vector<QString> Timeline::partNames(int global_rows)
+      {
+      QList<Part*> part_list = getParts();
+      std::vector<QString> part_names(global_rows);
+      for (int row = 0; row < global_rows && row < part_list.size(); row++) {
+            QTextDocument doc;
+            doc.setHtml(part_list.at(row)->longName());
+            part_names[row] = doc.toPlainText();
+            if (part_names[row].isEmpty())
+                  part_names[row] = part_list.at(row)->instrumentName();
+            }
+      return part_names;
+      }
+
+//---------------------------------------------------------
+//   setCell
+//    Set measure, tooltip and color of a grid cell
+//---------------------------------------------------------
+
+void Timeline::setCell(QGraphicsRectItem* item, int row, Measure* measure, QChar initial_letter, const QString& part_name)
+      {
+      setMetaData(item, row, ElementType::INVALID, measure, false, 0);
+      item->setToolTip(initial_letter + QString(" ") + QString::number(measure->no() + 1) + QString(", ") + part_name);
+      item->setBrush(QBrush(colorBox(item)));
+      }
+
+//---------------------------------------------------------
+//   drawMetas
+//    Add the meta values of a measure, x_pos is the left
+//    edge of its column
+//---------------------------------------------------------
+
+void Timeline::drawMetas(Measure* cm, int x_pos)
+      {
+      unsigned int num_metas = nmetas();
+      int stagger = 0;
 
       //Create stagger array if collapsed_meta is false
 #if (!defined (_MSCVER) && !defined (_MSC_VER))
@@ -950,69 +1065,75 @@ void Timeline::drawGrid(int global_rows, int global_cols)
 #endif
 
       bool no_key = true;
+      std::get<0>(repeat_info) = 0;
       std::get<4>(repeat_info) = false;
+      global_measure_number = -1;
 
-      for (Measure* cm = _score->firstMeasure(); cm; cm = cm->nextMeasure()) {
-            for (Segment* curr_seg = cm->first(); curr_seg; curr_seg = curr_seg->next()) {
-                  //Toggle no_key if initial key signature is found
-                  if (curr_seg->isKeySigType() && cm == _score->firstMeasure()) {
-                        if (no_key && curr_seg->tick().isZero())
-                              no_key = false;
-                        }
+      for (Segment* curr_seg = cm->first(); curr_seg; curr_seg = curr_seg->next()) {
+            //Toggle no_key if initial key signature is found
+            if (curr_seg->isKeySigType() && cm == _score->firstMeasure()) {
+                  if (no_key && curr_seg->tick().isZero())
+                        no_key = false;
+                  }
 
-                  //If no initial key signature is found, add key signature
-                  if (cm == _score->firstMeasure() && no_key &&
-                      (curr_seg->isTimeSigType() || curr_seg->isChordRestType())) {
+            //If no initial key signature is found, add key signature
+            if (cm == _score->firstMeasure() && no_key &&
+                (curr_seg->isTimeSigType() || curr_seg->isChordRestType())) {
 
-                        if (getMetaRow(tr("Key Signature")) != num_metas) {
-                              if (collapsed_meta)
-                                    key_meta(0, &stagger, x_pos);
-                              else
-                                    key_meta(0, &stagger_arr[getMetaRow(tr("Key Signature"))], x_pos);
-                              }
-                        no_key = false;
-                        }
-                  int row = 0;
-                  for (auto it = metas.begin(); it != metas.end(); ++it) {
-                        std::tuple<QString, void (Timeline::*)(Segment*, int*, int), bool> meta = *it;
-                        if (!std::get<2>(meta))
-                              continue;
-                        void (Timeline::*func)(Segment*, int*, int) = std::get<1>(meta);
+                  if (getMetaRow(tr("Key Signature")) != num_metas) {
                         if (collapsed_meta)
-                              (this->*func)(curr_seg, &stagger, x_pos);
+                              key_meta(0, &stagger, x_pos);
                         else
-                              (this->*func)(curr_seg, &stagger_arr[row], x_pos);
-                        row++;
+                              key_meta(0, &stagger_arr[getMetaRow(tr("Key Signature"))], x_pos);
                         }
+                  no_key = false;
+                  }
+            int row = 0;
+            for (auto it = metas.begin(); it != metas.end(); ++it) {
+                  std::tuple<QString, void (Timeline::*)(Segment*, int*, int), bool> meta = *it;
+                  if (!std::get<2>(meta))
+                        continue;
+                  void (Timeline::*func)(Segment*, int*, int) = std::get<1>(meta);
+                  if (collapsed_meta)
+                        (this->*func)(curr_seg, &stagger, x_pos);
+                  else
+                        (this->*func)(curr_seg, &stagger_arr[row], x_pos);
+                  row++;
+                  }
+            }
+      //Handle all jumps here
+      if (getMetaRow(tr("Jumps and Markers")) != num_metas) {
+            ElementList measure_elements_list = cm->el();
+            for (Element* element : measure_elements_list) {
+                  std::get<3>(repeat_info) = element;
+                  if (element->isMarker())
+                        jump_marker_meta(0, &stagger, x_pos);
                   }
-            //Handle all jumps here
-            if (getMetaRow(tr("Jumps and Markers")) != num_metas) {
-                  ElementList measure_elements_list = cm->el();
-                  for (Element* element : measure_elements_list) {
-                        std::get<3>(repeat_info) = element;
-                        if (element->isMarker())
+            for (Element* element : measure_elements_list) {
+                  if (element->isJump()) {
+                        std::get<2>(repeat_info) = element;
+                        if (collapsed_meta)
                               jump_marker_meta(0, &stagger, x_pos);
-                        }
-                  for (Element* element : measure_elements_list) {
-                        if (element->isJump()) {
-                              std::get<2>(repeat_info) = element;
-                              if (collapsed_meta)
-                                    jump_marker_meta(0, &stagger, x_pos);
-                              else
-                                    jump_marker_meta(0, &std::get<0>(repeat_info), x_pos);
-                              }
+                        else
+                              jump_marker_meta(0, &std::get<0>(repeat_info), x_pos);
                         }
                   }
-            stagger = 0;
-            std::get<0>(repeat_info) = 0;
-
-            for (unsigned int row = 0; row < num_metas; row++) {
-                  stagger_arr[row] = 0;
-                  }
-            x_pos += grid_width;
-            std::get<4>(repeat_info) = false;
             }
-      drawSelection();
+      std::get<0>(repeat_info) = 0;
+      std::get<4>(repeat_info) = false;
+      }
+
+//---------------------------------------------------------
+//   addColumnItem
+//    Remember a meta value item of the column at pos, to be
+//    removed when the measure is drawn again
+//---------------------------------------------------------
+
+void Timeline::addColumnItem(int pos, QGraphicsItem* item)
+      {
+      size_t col = pos / grid_width;
+      if (col < meta_columns.size())
+            meta_columns[col].push_back(item);
       }
 
 //---------------------------------------------------------
@@ -1380,6 +1501,7 @@ void Timeline::measure_meta(Segment* , int* , int pos)
 
             std::pair<QGraphicsItem*, int> pair_measure_text(graphics_text_item, row);
             meta_rows.push_back(pair_measure_text);
+            addColumnItem(pos, graphics_text_item);
             }
       }
 
@@ -1527,6 +1649,8 @@ bool Timeline::addMetaValue(int x, int pos, QString meta_text, int row, ElementT
       std::pair<QGraphicsItem*, int> pair_time_text(item_to_add, row);
       meta_rows.push_back(pair_time_rect);
       meta_rows.push_back(pair_time_text);
+      addColumnItem(pos, graphics_rect_item);
+      addColumnItem(pos, item_to_add);
 
       if (meta_text == QString("End repeat"))
             std::get<0>(repeat_info)++;
@@ -1729,6 +1853,8 @@ void Timeline::changeSelection(SelState)
 
 void Timeline::drawSelection()
       {
+      removeHighlight();
+
       selection_path = QPainterPath();
       selection_path.setFillRule(Qt::WindingFill);
 
@@ -1827,7 +1953,7 @@ void Timeline::drawSelection()
                               if (element == target_element) {
                                     QGraphicsRectItem* graphics_rect_item = qgraphicsitem_cast<QGraphicsRectItem*>(graphics_item);
                                     if (graphics_rect_item)
-                                          graphics_rect_item->setBrush(QBrush(QColor(173,216,230)));
+                                          highlightItem(graphics_rect_item, QColor(173,216,230));
                                     }
                               }
                         }
@@ -1837,7 +1963,7 @@ void Timeline::drawSelection()
                               if (graphics_rect_item) {
                                     for (int track = 0; track < _score->nstaves() * VOICES; track++) {
                                           if (element == seg->element(track))
-                                                graphics_rect_item->setBrush(QBrush(QColor(173,216,230)));
+                                                highlightItem(graphics_rect_item, QColor(173,216,230));
                                           }
                                     }
                               }
@@ -1845,20 +1971,21 @@ void Timeline::drawSelection()
                   else {
                         QGraphicsRectItem* graphics_rect_item = qgraphicsitem_cast<QGraphicsRectItem*>(graphics_item);
                         if (graphics_rect_item)
-                              graphics_rect_item->setBrush(QBrush(QColor(173,216,230)));
+                              highlightItem(graphics_rect_item, QColor(173,216,230));
                         }
                   }
             //Change color from gray to only blue
             else if (it != meta_labels_set.end()) {
                   QGraphicsRectItem* graphics_rect_item = qgraphicsitem_cast<QGraphicsRectItem*>(graphics_item);
-                  graphics_rect_item->setBrush(QBrush(QColor(graphics_rect_item->brush().color().red(),
-                                                             graphics_rect_item->brush().color().green(),
-                                                             255)));
+                  highlightItem(graphics_rect_item, QColor(graphics_rect_item->brush().color().red(),
+                                                           graphics_rect_item->brush().color().green(),
+                                                           255));
                   selection_path.addRect(graphics_rect_item->rect());
                   }
             }
 
       QGraphicsPathItem* graphics_path_item = new QGraphicsPathItem(selection_path.simplified());
+      selection_item = graphics_path_item;
       if (selection.isRange())
             graphics_path_item->setPen(QPen(QColor(0, 0, 255), 3));
       else
@@ -2232,21 +2359,144 @@ void Timeline::wheelEvent(QWheelEvent* event)
 //   updateGrid
 //---------------------------------------------------------
 
-void Timeline::updateGrid()
+void Timeline::updateGrid(bool force)
       {
       if (!isVisible())
             return;
 
       if (_score && _score->firstMeasure()) {
-            drawGrid(nstaves(), _score->nmeasures());
-            updateView();
-            drawSelection();
-            mouseOver(mapToScene(mapFromGlobal(QCursor::pos())));
-            row_names->updateLabels(getLabels(), grid_height);
+            if (force || update_full || gridSizeChanged()) {
+                  drawGrid(nstaves(), _score->nmeasures());
+                  updateView();
+                  drawSelection();
+                  mouseOver(mapToScene(mapFromGlobal(QCursor::pos())));
+                  row_names->updateLabels(getLabels(), grid_height);
+                  }
+            else {
+                  clearHover();
+                  if (update_start_tick >= Fraction(0,1)) {
+                        drawRange();
+                        updateView();
+                        }
+                  //Otherwise only the selection needs an update
+                  drawSelection();
+                  mouseOver(mapToScene(mapFromGlobal(QCursor::pos())));
+                  }
             }
       viewport()->update();
       }
 
+//---------------------------------------------------------
+//   gridSizeChanged
+//    Returns true if staves or measures have been added or
+//    removed since the grid was drawn
+//---------------------------------------------------------
+
+bool Timeline::gridSizeChanged()
+      {
+      return grid_rows != nstaves()
+         || grid_cols != _score->nmeasures()
+         || int(grid_cells.size()) != grid_rows * grid_cols;
+      }
+
+//---------------------------------------------------------
+//   layoutChanged
+//    Called on every layout of the score, collects the
+//    range of the command to be redrawn by the next
+//    updateGrid()
+//---------------------------------------------------------
+
+void Timeline::layoutChanged()
+      {
+      if (!_score)
+            return;
+      const CmdState& cs = _score->masterScore()->cmdState();
+      if (!cs.layoutRange() || cs.startTick() < Fraction(0,1) || cs._instrumentsChanged || cs._excerptsChanged) {
+            update_full = true;
+            return;
+            }
+      if (update_start_tick < Fraction(0,1) || cs.startTick() < update_start_tick)
+            update_start_tick = cs.startTick();
+      if (cs.endTick() > update_end_tick)
+            update_end_tick = cs.endTick();
+
+      // staff numbers of the command state are those of the master score
+      if (cs.startStaff() == -1 || !_score->isMaster())
+            update_all_rows = true;
+      else {
+            if (update_start_staff == -1 || cs.startStaff() < update_start_staff)
+                  update_start_staff = cs.startStaff();
+            if (cs.endStaff() > update_end_staff)
+                  update_end_staff = cs.endStaff();
+            }
+      }
+
+//---------------------------------------------------------
+//   resetUpdateRange
+//---------------------------------------------------------
+
+void Timeline::resetUpdateRange()
+      {
+      update_start_tick  = Fraction(-1,1);
+      update_end_tick    = Fraction(-1,1);
+      update_start_staff = -1;
+      update_end_staff   = -1;
+      update_all_rows    = false;
+      update_full        = false;
+      }
+
+//---------------------------------------------------------
+//   drawRange
+//    Update the cells and meta values of the measures in
+//    the range collected by layoutChanged(). All rows of a
+//    column are updated if its measure has been replaced.
+//---------------------------------------------------------
+
+void Timeline::drawRange()
+      {
+      //Restore the brushes before cells get their new color
+      removeHighlight();
+
+      QString translate_measure = tr("Measure");
+      QChar initial_letter = translate_measure[0];
+      std::vector<QString> part_names = partNames(grid_rows);
+      const int first_row = update_all_rows ? 0 : qMax(update_start_staff, 0);
+      const int last_row  = update_all_rows ? grid_rows - 1 : qMin(update_end_staff, grid_rows - 1);
+
+      std::vector<std::pair<Measure*, int>> columns;
+      std::set<QGraphicsItem*> old_items;
+      int col = 0;
+      for (Measure* m = _score->firstMeasure(); m && col < grid_cols; m = m->nextMeasure(), col++) {
+            QGraphicsRectItem** cells = &grid_cells[col * grid_rows];
+            const bool replaced = static_cast<Measure*>(cells[0]->data(2).value<void*>()) != m;
+            if (!replaced && (m->endTick() <= update_start_tick || m->tick() > update_end_tick))
+                  continue;
+            for (int row = 0; row < grid_rows; row++) {
+                  if (replaced || (row >= first_row && row <= last_row))
+                        setCell(cells[row], row, m, initial_letter, part_names[row]);
+                  }
+            for (QGraphicsItem* item : meta_columns[col]) {
+                  scene()->removeItem(item);
+                  old_items.insert(item);
+                  }
+            meta_columns[col].clear();
+            columns.emplace_back(m, col);
+            }
+
+      //Remove the old meta values before new ones are added,
+      //which may get the same addresses
+      if (!old_items.empty()) {
+            meta_rows.erase(std::remove_if(meta_rows.begin(), meta_rows.end(), [&old_items](const std::pair<QGraphicsItem*, int>& p) {
+                  return old_items.count(p.first);
+                  }), meta_rows.end());
+            qDeleteAll(old_items);
+            }
+      for (const std::pair<Measure*, int>& c : columns)
+            drawMetas(c.first, c.second * grid_width);
+
+      resetUpdateRange();
+      }
+
 //---------------------------------------------------------
 //   setScore
 //---------------------------------------------------------
@@ -2255,6 +2505,13 @@ void Timeline::setScore(Score* s)
       {
       _score = s;
       scene()->clear();
+      clearSelectionItems();
+      std::get<0>(old_hover_info) = nullptr;
+      grid_cells.clear();
+      meta_columns.clear();
+      grid_rows = -1;
+      grid_cols = -1;
+      resetUpdateRange();
 
       if (_score) {
             connect(_score, &QObject::destroyed, this, &Timeline::objectDestroyed, Qt::UniqueConnection);
@@ -21,6 +21,7 @@
 #define __TIMELINE_H__
 
 
+#include "libmscore/score.h"
 #include "libmscore/select.h"
 #include "scoreview.h"
 #include <vector>
@@ -137,6 +138,8 @@ class Timeline : public QGraphicsView {
       std::vector<std::pair<QGraphicsItem*, int>> meta_rows;
 
       QPainterPath selection_path;
+      QGraphicsPathItem* selection_item = nullptr;
+      std::vector<std::pair<QGraphicsRectItem*, QBrush>> selected_cells;    // highlighted items and their original brush
       QRectF old_selection_rect;
       bool mouse_pressed = false;
       QPoint old_loc;
@@ -156,6 +159,33 @@ class Timeline : public QGraphicsView {
       void setMetaData(QGraphicsItem* gi, int staff, ElementType et, Measure* m, bool full_measure, Element* e, QGraphicsItem* pair_item = nullptr, Segment* seg = nullptr);
       unsigned int getMetaRow(QString target_text);
 
+      //Size the grid was drawn for and its cells, column by column
+      int grid_rows { -1 };
+      int grid_cols { -1 };
+      std::vector<QGraphicsRectItem*> grid_cells;
+      std::vector<std::vector<QGraphicsItem*>> meta_columns;    // meta value items of each measure column
+      bool gridSizeChanged();
+
+      //Range changed by the commands since the grid was drawn
+      Fraction update_start_tick { -1, 1 };
+      Fraction update_end_tick   { -1, 1 };
+      int update_start_staff     { -1 };
+      int update_end_staff       { -1 };
+      bool update_all_rows       { false };
+      bool update_full           { false };
+      void resetUpdateRange();
+      void drawRange();
+
+      std::vector<QString> partNames(int global_rows);
+      void setCell(QGraphicsRectItem* item, int row, Measure* measure, QChar initial_letter, const QString& part_name);
+      void drawMetas(Measure* measure, int x_pos);
+      void addColumnItem(int pos, QGraphicsItem* item);
+
+      void highlightItem(QGraphicsRectItem* item, const QColor& color);
+      void removeHighlight();
+      void clearSelectionItems();
+      void clearHover();
+
       int global_measure_number { 0 };
       int global_z_value        { 0 };
 
@@ -198,6 +228,8 @@ class Timeline : public QGraphicsView {
       void drawGrid(int global_rows, int global_cols);
 
       void setScore(Score* s);
+      Score* score() const { return _score; }
+      void layoutChanged();
       void setScoreView(ScoreView* sv);
 
       int nstaves();
@@ -205,7 +237,7 @@ class Timeline : public QGraphicsView {
       int getWidth();
       int getHeight();
 
-      void updateGrid();
+      void updateGrid(bool force = true);
 
       QColor colorBox(QGraphicsRectItem* item);
 
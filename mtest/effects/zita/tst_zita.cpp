@@ -0,0 +1,133 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2019 Werner Schweer and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#include <QtTest/QtTest>
+
+#include "mtest/testutils.h"
+#include "effects/zita1/zita.h"
+
+using namespace Ms;
+
+static const int sampleRate = 44100;
+
+//---------------------------------------------------------
+//   TestZita
+//---------------------------------------------------------
+
+class TestZita : public QObject, public MTest
+      {
+      Q_OBJECT
+
+      std::vector<float> input;
+
+      void setup(ZitaReverb* r, bool vectorized);
+
+   private slots:
+      void initTestCase();
+      void vectorizedMatchesScalar();
+      void benchmark_data();
+      void benchmark();
+      };
+
+//---------------------------------------------------------
+//   initTestCase
+//    four seconds of stereo noise bursts
+//---------------------------------------------------------
+
+void TestZita::initTestCase()
+      {
+      initMTest();
+      const int frames = 4 * sampleRate;
+      input.resize(frames * 2);
+      quint32 seed = 1;
+      for (int i = 0; i < frames * 2; ++i) {
+            seed = seed * 1664525 + 1013904223;
+            bool burst = (i / 2) % 20000 < 3000;
+            input[i] = burst ? float(seed >> 8) / float(1 << 24) - 0.5f : 0.0f;
+            }
+      }
+
+//---------------------------------------------------------
+//   setup
+//    non default parameters, so that both equalizers
+//    are active
+//---------------------------------------------------------
+
+void TestZita::setup(ZitaReverb* r, bool vectorized)
+      {
+      r->init(sampleRate);
+      r->setVectorized(vectorized);
+      r->set_delay(0.06f);
+      r->set_rtmid(3.0f);
+      r->set_eq1gn(6.0f);
+      r->set_eq2gn(-4.0f);
+      }
+
+//---------------------------------------------------------
+//   vectorizedMatchesScalar
+//    feed both implementations with periods of varying
+//    size and change parameters halfway
+//---------------------------------------------------------
+
+void TestZita::vectorizedMatchesScalar()
+      {
+      ZitaReverb vr;
+      ZitaReverb sr;
+      setup(&vr, true);
+      setup(&sr, false);
+
+      const int frames = int(input.size() / 2);
+      std::vector<float> vout(input.size());
+      std::vector<float> sout(input.size());
+      int n = 1;
+      for (int pos = 0; pos < frames; pos += n) {
+            n = qMin(n * 7 % 509 + 1, frames - pos);
+            if (pos > frames / 2) {
+                  vr.set_eq1gn(-3.0f);
+                  sr.set_eq1gn(-3.0f);
+                  }
+            vr.process(n, &input[pos * 2], &vout[pos * 2]);
+            sr.process(n, &input[pos * 2], &sout[pos * 2]);
+            }
+
+      float maxDiff = 0.0f;
+      for (size_t i = 0; i < vout.size(); ++i)
+            maxDiff = qMax(maxDiff, qAbs(vout[i] - sout[i]));
+      QVERIFY(maxDiff < 1e-5f);
+      }
+
+//---------------------------------------------------------
+//   benchmark
+//---------------------------------------------------------
+
+void TestZita::benchmark_data()
+      {
+      QTest::addColumn<bool>("vectorized");
+      QTest::newRow("scalar")     << false;
+      QTest::newRow("vectorized") << true;
+      }
+
+void TestZita::benchmark()
+      {
+      QFETCH(bool, vectorized);
+      ZitaReverb r;
+      setup(&r, vectorized);
+      const int frames = int(input.size() / 2);
+      std::vector<float> out(input.size());
+      QBENCHMARK {
+            for (int pos = 0; pos < frames; pos += 256)
+                  r.process(qMin(256, frames - pos), &input[pos * 2], &out[pos * 2]);
+            }
+      }
+
+QTEST_MAIN(TestZita)
+#include "tst_zita.moc"
@@ -46,6 +46,7 @@ class TestChordSymbol : public QObject, public MTest {
       void testNoSystem();
       void testTranspose();
       void testTransposePart();
+      void testLookup();
       };
 
 //---------------------------------------------------------
@@ -194,5 +195,30 @@ void TestChordSymbol::testTransposePart()
       test_post(score, "transpose-part");
       }
 
+void TestChordSymbol::testLookup()
+      {
+      MasterScore* score = test_pre("extend");
+      Harmony* h1 = new Harmony(score);
+      h1->setHarmony("C7");
+      Harmony* h2 = new Harmony(score);
+      h2->setHarmony("D7");
+      QVERIFY(h1->descr());
+      QCOMPARE(h1->id(), h2->id());
+
+      // chord unknown to the chord list gets a generated description, which is found again
+      Harmony* h3 = new Harmony(score);
+      h3->setHarmony("C7b5#5b9#9#11b13");
+      Harmony* h4 = new Harmony(score);
+      h4->setHarmony("D7b5#5b9#9#11b13");
+      QVERIFY(h3->descr());
+      QCOMPARE(h3->id(), h4->id());
+
+      delete h1;
+      delete h2;
+      delete h3;
+      delete h4;
+      delete score;
+      }
+
 QTEST_MAIN(TestChordSymbol)
 #include "tst_chordsymbol.moc"
@@ -24,6 +24,13 @@
 
 using namespace Ms;
 
+// how the clipboard content is built and read back
+enum class Clipboard : char {
+      XML,              // Selection::mimeData()
+      BINARY,           // Selection::createMimeData(), pasted from the token stream
+      XML_FALLBACK      // xml text generated from the token stream, as seen by other applications
+      };
+
 //---------------------------------------------------------
 //   TestCopyPaste
 //---------------------------------------------------------
@@ -32,7 +39,7 @@ class TestCopyPaste : public QObject, public MTest
       {
       Q_OBJECT
 
-      void copypaste(const char*);
+      void copypaste(const char*, Clipboard = Clipboard::XML);
       void copypastestaff(const char*);
       void copypastevoice(const char*, int);
       void copypastetuplet(const char*);
@@ -65,6 +72,15 @@ class TestCopyPaste : public QObject, public MTest
       void copypaste24() { copypaste("24"); }       // more complex non reduced tuplet
       void copypaste25() { copypaste("25"); }       // copy full measure rest
 
+      void copypasteBinary03() { copypaste("03", Clipboard::BINARY); }   // slur
+      void copypasteBinary06() { copypaste("06", Clipboard::BINARY); }   // tie
+      void copypasteBinary11() { copypaste("11", Clipboard::BINARY); }   // grace notes
+      void copypasteBinary19() { copypaste("19", Clipboard::BINARY); }   // chord symbols
+      void copypasteBinary22() { copypaste("22", Clipboard::BINARY); }   // cross-staff slur
+      void copypasteBinary23() { copypaste("23", Clipboard::BINARY); }   // full measure tuplet 10/8
+      void copypasteXmlFallback03() { copypaste("03", Clipboard::XML_FALLBACK); }
+      void copypasteXmlFallback19() { copypaste("19", Clipboard::XML_FALLBACK); }
+
       void copypastestaff50() { copypastestaff("50"); }       // staff & slurs
 
       void copyPastePartial();
@@ -87,7 +103,7 @@ void TestCopyPaste::initTestCase()
 //    copy measure 2, paste into measure 4
 //---------------------------------------------------------
 
-void TestCopyPaste::copypaste(const char* idx)
+void TestCopyPaste::copypaste(const char* idx, Clipboard clipboard)
       {
       MasterScore* score = readScore(DIR + QString("copypaste%1.mscx").arg(idx));
       Measure* m1 = score->firstMeasure();
@@ -106,9 +122,23 @@ void TestCopyPaste::copypaste(const char* idx)
       QVERIFY(score->selection().canCopy());
       QString mimeType = score->selection().mimeType();
       QVERIFY(!mimeType.isEmpty());
-      QMimeData* mimeData = new QMimeData;
-      QByteArray ba = score->selection().mimeData();
-      mimeData->setData(mimeType, ba);
+      QMimeData* mimeData;
+      if (clipboard == Clipboard::XML) {
+            mimeData = new QMimeData;
+            mimeData->setData(mimeType, score->selection().mimeData());
+            }
+      else {
+            mimeData = score->selection().createMimeData();
+            QVERIFY(mimeData->hasFormat(mimeStaffListBinaryFormat));
+            QVERIFY(mimeData->hasFormat(mimeStaffListFormat));
+            if (clipboard == Clipboard::XML_FALLBACK) {
+                  QByteArray xml = mimeData->data(mimeStaffListFormat);
+                  QVERIFY(xml.startsWith("<?xml"));
+                  delete mimeData;
+                  mimeData = new QMimeData;
+                  mimeData->setData(mimeStaffListFormat, xml);
+                  }
+            }
       QApplication::clipboard()->setMimeData(mimeData);
       QVERIFY(m4->first()->element(0) != 0);
       score->select(m4->first()->element(0));
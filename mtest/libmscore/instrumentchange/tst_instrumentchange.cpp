@@ -20,6 +20,7 @@
 #include "libmscore/staff.h"
 #include "libmscore/part.h"
 #include "libmscore/undo.h"
+#include "libmscore/instrtemplate.h"
 #include "synthesizer/midipatch.h"
 
 #define DIR QString("libmscore/instrumentchange/")
@@ -43,6 +44,7 @@ class TestInstrumentChange : public QObject, public MTest {
       void testChange();
       void testMixer();
       void testCopy();
+      void testTemplatesCache();
       };
 
 //---------------------------------------------------------
@@ -154,5 +156,34 @@ void TestInstrumentChange::testCopy()
       test_post(score, "copy");
       }
 
+//---------------------------------------------------------
+//   testTemplatesCache
+//    instrument templates read from the startup cache
+//    must be identical to the templates read from xml
+//---------------------------------------------------------
+
+void TestInstrumentChange::testTemplatesCache()
+      {
+      QVERIFY(saveInstrumentTemplates("templates-xml.xml"));
+
+      QBuffer buffer;
+      buffer.open(QIODevice::WriteOnly);
+      QDataStream out(&buffer);
+      QVERIFY(saveInstrumentTemplatesCache(out));
+      buffer.close();
+
+      buffer.open(QIODevice::ReadOnly);
+      QDataStream in(&buffer);
+      QVERIFY(loadInstrumentTemplatesCache(in));
+      QVERIFY(!instrumentGroups.isEmpty());
+      QVERIFY(saveInstrumentTemplates("templates-cache.xml"));
+
+      QFile f1("templates-xml.xml");
+      QFile f2("templates-cache.xml");
+      QVERIFY(f1.open(QIODevice::ReadOnly));
+      QVERIFY(f2.open(QIODevice::ReadOnly));
+      QCOMPARE(f2.readAll(), f1.readAll());
+      }
+
 QTEST_MAIN(TestInstrumentChange)
 #include "tst_instrumentchange.moc"
@@ -13,6 +13,7 @@
 #include <QtTest/QtTest>
 #include "mtest/testutils.h"
 #include "libmscore/score.h"
+#include "libmscore/mempool.h"
 
 #define DIR QString("libmscore/layout/")
 
@@ -39,6 +40,7 @@ class TestBenchmark : public QObject, public MTest
       void benchmark1();
       void benchmark2();
       void benchmark4();            // incremental layout (one page)
+      void memoryPool();            // layout reuses pooled elements
       };
 
 //---------------------------------------------------------
@@ -89,6 +91,26 @@ void TestBenchmark::benchmark4()
             }
       }
 
+//---------------------------------------------------------
+//   memoryPool
+//    a warm layout takes pooled elements (ledger lines,
+//    spanner segments, ...) from the blocks freed by the
+//    previous layout
+//---------------------------------------------------------
+
+void TestBenchmark::memoryPool()
+      {
+      score->doLayout();
+      MemoryPool::resetStatistics();
+      score->doLayout();
+      MemoryPool::Statistics st = MemoryPool::statistics();
+      qDebug("pool: %lld allocations, %lld reused, %lld from heap, %lld live",
+         st.allocations, st.reused, st.heapAllocations, st.live());
+      QVERIFY(st.allocations > 0);
+      QVERIFY(st.reused > 0);
+      QCOMPARE(st.reused + st.heapAllocations, st.allocations);
+      }
+
 QTEST_MAIN(TestBenchmark)
 #include "tst_benchmark.moc"
 
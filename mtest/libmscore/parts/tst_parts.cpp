@@ -61,6 +61,7 @@ class TestParts : public QObject, public MTest
 
       void createPart1();
       void createPart2();
+      void createPartsParallel();
       void voicesExcerpt();
 
       void createPartBreath();
@@ -105,6 +106,7 @@ class TestParts : public QObject, public MTest
 
       void appendMeasure();
       void insertMeasure();
+      void correspondingMeasures();
 //      void styleScore();
 //      void styleScoreReload();
 //      void stylePartDefault();
@@ -294,6 +296,52 @@ void TestParts::insertMeasure()
       delete score;
       }
 
+//---------------------------------------------------------
+//   correspondingMeasures
+//    the measure index must follow inserted and removed
+//    measures and agree with tick2measure in every part
+//---------------------------------------------------------
+
+static bool checkCorrespondingMeasures(MasterScore* score)
+      {
+      for (Score* s : score->scoreList()) {
+            if (s->measures()->measureIndex().size() != score->measures()->measureIndex().size())
+                  return false;
+            for (Measure* m = score->firstMeasure(); m; m = m->nextMeasure()) {
+                  Measure* nm = s->correspondingMeasure(m);
+                  if (!nm || nm != s->tick2measure(m->tick()))
+                        return false;
+                  for (Segment* seg = m->first(); seg; seg = seg->next()) {
+                        Segment* ns = s->correspondingSegment(seg);
+                        if (ns && ns != nm->findSegment(seg->segmentType(), seg->tick()))
+                              return false;
+                        }
+                  }
+            }
+      return true;
+      }
+
+void TestParts::correspondingMeasures()
+      {
+      MasterScore* score = readScore(DIR + "part-all.mscx");
+      QVERIFY(score);
+      createParts(score);
+      QVERIFY(checkCorrespondingMeasures(score));
+
+      score->startCmd();
+      score->insertMeasure(ElementType::MEASURE, score->firstMeasure()->nextMeasure());
+      score->insertMeasure(ElementType::MEASURE, 0);
+      score->endCmd();
+      QVERIFY(checkCorrespondingMeasures(score));
+
+      score->undoRedo(true, 0);
+      QVERIFY(checkCorrespondingMeasures(score));
+
+      score->undoRedo(false, 0);
+      QVERIFY(checkCorrespondingMeasures(score));
+      delete score;
+      }
+
 #if 0
 //---------------------------------------------------------
 //   styleScore
@@ -369,6 +417,34 @@ void TestParts::createPart2()
       testPartCreation("part-all");
       }
 
+//---------------------------------------------------------
+//   createPartsParallel
+//    cloning both parts at the same time has to give the
+//    same result as creating them one after the other
+//---------------------------------------------------------
+
+void TestParts::createPartsParallel()
+      {
+      for (const QString& test : { QString("part-all"), QString("part-54346") }) {
+            MasterScore* score = readScore(DIR + test + ".mscx");
+            QVERIFY(score);
+            QList<Excerpt*> excerpts;
+            for (int i = 0; i < 2; ++i) {
+                  Part* part = score->parts().at(i);
+                  Excerpt* ex = new Excerpt(score);
+                  ex->setPartScore(new Score(score));
+                  ex->parts().append(part);
+                  ex->setTitle(part->partName());
+                  excerpts.append(ex);
+                  }
+            Excerpt::createExcerpts(excerpts);
+            score->excerpts().append(excerpts);
+            score->setExcerptsChanged(true);
+            QVERIFY(saveCompareScore(score, test + "-parallel.mscx", DIR + test + "-parts.mscx"));
+            delete score;
+            }
+      }
+
 void TestParts::createPartBreath()
       {
       testPartCreation("part-breath");
@@ -13,6 +13,8 @@
 #include <QtTest/QtTest>
 #include "mtest/testutils.h"
 #include "libmscore/score.h"
+#include "libmscore/measure.h"
+#include "libmscore/undo.h"
 
 #define DIR QString("libmscore/readwriteundoreset/")
 
@@ -33,6 +35,9 @@ class TestReadWrite : public QObject, public MTest
       void initTestCase();
       void barlines()         { runtests("barlines");          }
       void slurs()            { runtests("slurs");             }
+      void undoCoalesce();
+      void undoPropertyBatch();
+      void undoMemoryLimit();
       };
 
 //---------------------------------------------------------
@@ -74,5 +79,104 @@ void TestReadWrite::undoreset(const QString& file)
       QVERIFY(saveCompareScore(score, writeFile, readFile));
       }
 
+//---------------------------------------------------------
+//   undoCoalesce
+//    repeated changes of one property in a command keep a
+//    single undo record
+//---------------------------------------------------------
+
+void TestReadWrite::undoCoalesce()
+      {
+      MasterScore* score = readScore(DIR + "barlines.mscx");
+      QVERIFY(score);
+      Measure* m = score->firstMeasure();
+      QVERIFY(m);
+      const QVariant oldStretch = m->getProperty(Pid::USER_STRETCH);
+
+      score->startCmd();
+      m->undoChangeProperty(Pid::USER_STRETCH, 1.5);
+      const int n = score->undoStack()->current()->childCount();
+      m->undoChangeProperty(Pid::USER_STRETCH, 2.0);
+      m->undoChangeProperty(Pid::USER_STRETCH, 3.0);
+      QCOMPARE(score->undoStack()->current()->childCount(), n);
+      score->endCmd();
+      QCOMPARE(m->getProperty(Pid::USER_STRETCH).toDouble(), 3.0);
+
+      score->undoRedo(true, nullptr);
+      QCOMPARE(m->getProperty(Pid::USER_STRETCH), oldStretch);
+      score->undoRedo(false, nullptr);
+      QCOMPARE(m->getProperty(Pid::USER_STRETCH).toDouble(), 3.0);
+      delete score;
+      }
+
+//---------------------------------------------------------
+//   undoPropertyBatch
+//    property changes of one command are stored in a
+//    single batch
+//---------------------------------------------------------
+
+void TestReadWrite::undoPropertyBatch()
+      {
+      MasterScore* score = readScore(DIR + "barlines.mscx");
+      QVERIFY(score);
+      QList<QVariant> oldStretch;
+      for (Measure* m = score->firstMeasure(); m; m = m->nextMeasure())
+            oldStretch.append(m->getProperty(Pid::USER_STRETCH));
+
+      score->startCmd();
+      for (Measure* m = score->firstMeasure(); m; m = m->nextMeasure())
+            m->undoChangeProperty(Pid::USER_STRETCH, 2.5);
+      UndoMacro* macro = score->undoStack()->current();
+      QCOMPARE(macro->childCount(), 1);
+      QCOMPARE(macro->commands().front()->name(), "ChangePropertyBatch");
+      QCOMPARE(static_cast<ChangePropertyBatch*>(macro->commands().front())->size(), oldStretch.size());
+      score->endCmd();
+
+      score->undoRedo(true, nullptr);
+      int i = 0;
+      for (Measure* m = score->firstMeasure(); m; m = m->nextMeasure())
+            QCOMPARE(m->getProperty(Pid::USER_STRETCH), oldStretch[i++]);
+      score->undoRedo(false, nullptr);
+      for (Measure* m = score->firstMeasure(); m; m = m->nextMeasure())
+            QCOMPARE(m->getProperty(Pid::USER_STRETCH).toDouble(), 2.5);
+      delete score;
+      }
+
+//---------------------------------------------------------
+//   undoMemoryLimit
+//    the oldest commands are dropped when the undo stack
+//    exceeds its memory limit
+//---------------------------------------------------------
+
+void TestReadWrite::undoMemoryLimit()
+      {
+      MasterScore* score = readScore(DIR + "barlines.mscx");
+      QVERIFY(score);
+      UndoStack* undo = score->undoStack();
+      Measure* m = score->firstMeasure();
+      QVERIFY(m);
+
+      for (int i = 0; i < 4; ++i) {
+            score->startCmd();
+            m->undoChangeProperty(Pid::USER_STRETCH, 2.0 + i);    // 1.0 is the default and would not be recorded
+            score->endCmd();
+            }
+      QCOMPARE(undo->count(), 4);
+      QVERIFY(undo->memoryUsage() > 0);
+
+      undo->setMemoryLimit(1);
+      QCOMPARE(undo->count(), 1);
+      QCOMPARE(undo->evictedCount(), 3);
+      QCOMPARE(undo->getCurIdx(), 4);
+      QVERIFY(undo->memoryUsage() > 1);
+
+      // the remaining command can still be undone
+      score->undoRedo(true, nullptr);
+      QCOMPARE(m->getProperty(Pid::USER_STRETCH).toDouble(), 4.0);
+      QVERIFY(!undo->canUndo());
+      QCOMPARE(undo->getCurIdx(), 3);
+      delete score;
+      }
+
 QTEST_MAIN(TestReadWrite)
 #include "tst_readwriteundoreset.moc"
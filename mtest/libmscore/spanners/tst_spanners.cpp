@@ -54,8 +54,46 @@ class TestSpanners : public QObject, public MTest
 //      void spanners13();            // drop a line break at the middle of a LyricsLine and check LyricsLineSegments
       void spanners14();            // creating part from an existing grand staff containing a cross staff glissando
       void spanners15();            // change the color & min distance of a line and save it
+      void spanners16();            // spanner lookup after moving, removing and adding spanners
+      void spanners17();            // spanners starting on the same tick are saved in a stable order
       };
 
+//---------------------------------------------------------
+//   checkSpannerLookup
+//    compare SpannerMap queries with a linear search
+//---------------------------------------------------------
+
+static bool checkSpannerLookup(Score* score)
+      {
+      SpannerMap& smap = score->spannerMap();
+      const int last = score->lastMeasure()->endTick().ticks();
+      const int step = MScore::division / 2;
+      for (int start = -step; start <= last; start += step) {
+            for (int stop = start; stop <= last + step; stop += 3 * step) {
+                  std::set<Spanner*> overlapping;
+                  std::set<Spanner*> contained;
+                  for (auto i : smap.map()) {
+                        Spanner* sp = i.second;
+                        if (sp->tick2().ticks() >= start && sp->tick().ticks() <= stop)
+                              overlapping.insert(sp);
+                        if (sp->tick().ticks() >= start && sp->tick2().ticks() <= stop)
+                              contained.insert(sp);
+                        }
+                  std::set<Spanner*> r1;
+                  for (auto i : smap.findOverlapping(start, stop))
+                        r1.insert(i.value);
+                  std::set<Spanner*> r2;
+                  for (auto i : smap.findContained(start, stop))
+                        r2.insert(i.value);
+                  if (r1 != overlapping || r2 != contained) {
+                        qDebug("spanner lookup failed for %d - %d", start, stop);
+                        return false;
+                        }
+                  }
+            }
+      return true;
+      }
+
 //---------------------------------------------------------
 //   initTestCase
 //---------------------------------------------------------
@@ -647,7 +685,93 @@ void TestSpanners::spanners15()
       delete score;
       }
 
+//---------------------------------------------------------
+///  spanners16
+///   The spanner lookup tree follows tick changes,
+///   removal and insertion of spanners.
+//---------------------------------------------------------
+
+void TestSpanners::spanners16()
+      {
+      MasterScore* score = readScore(DIR + "linecolor01.mscx");
+      QVERIFY(score);
+      SpannerMap& smap = score->spannerMap();
+      QVERIFY(!smap.map().empty());
+      QVERIFY(checkSpannerLookup(score));
+
+      Spanner* sp = smap.map().begin()->second;
+      sp->setTick(sp->tick() + Fraction(1, 4));
+      QVERIFY(checkSpannerLookup(score));
+      sp->setTicks(sp->ticks() + Fraction(1, 2));
+      QVERIFY(checkSpannerLookup(score));
+
+      QVERIFY(smap.removeSpanner(sp));
+      QVERIFY(checkSpannerLookup(score));
+      smap.addSpanner(sp);
+      QVERIFY(checkSpannerLookup(score));
+
+      smap.update();
+      delete score;
+      }
+
+//---------------------------------------------------------
+///  spanners17
+///   Spanners starting on the same tick are returned and
+///   saved in the order they were added, also after they
+///   were moved around in the lookup tree.
+//---------------------------------------------------------
+
+static QByteArray readFile(const QString& name)
+      {
+      QFile f(name);
+      return f.open(QIODevice::ReadOnly) ? f.readAll() : QByteArray();
+      }
 
+void TestSpanners::spanners17()
+      {
+      MasterScore* score = readScore(DIR + "linecolor01.mscx");
+      QVERIFY(score);
+      SpannerMap& smap = score->spannerMap();
+      Spanner* sp = smap.map().begin()->second;
+
+      std::vector<Spanner*> added { sp };
+      for (int i = 1; i <= 4; ++i) {
+            Spanner* c = toSpanner(sp->clone());
+            c->setColor(QColor(50 * i, 0, 0));
+            score->addSpanner(c);
+            added.push_back(c);
+            }
+
+      auto sameStart = [&]() {
+            std::vector<Spanner*> l;
+            for (auto i : smap.findOverlapping(sp->tick().ticks(), sp->tick().ticks())) {
+                  if (std::find(added.begin(), added.end(), i.value) != added.end())
+                        l.push_back(i.value);
+                  }
+            return l;
+            };
+      QVERIFY(sameStart() == added);
+      QVERIFY(saveScore(score, "spanners17-1.mscx"));
+
+      for (Spanner* s : added)
+            s->setTick(s->tick() + Fraction(1, 4));
+      for (Spanner* s : added)
+            s->setTick(s->tick() - Fraction(1, 4));
+      smap.update();
+      QVERIFY(sameStart() == added);
+      QVERIFY(saveScore(score, "spanners17-2.mscx"));
+      QByteArray saved = readFile("spanners17-1.mscx");
+      QVERIFY(!saved.isEmpty());
+      QCOMPARE(readFile("spanners17-2.mscx"), saved);
+
+      // a spanner added again goes after the others
+      QVERIFY(smap.removeSpanner(sp));
+      smap.addSpanner(sp);
+      added.erase(added.begin());
+      added.push_back(sp);
+      QVERIFY(sameStart() == added);
+      delete score;
+      }
 
 QTEST_MAIN(TestSpanners)
 #include "tst_spanners.moc"
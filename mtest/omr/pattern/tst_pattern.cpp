@@ -0,0 +1,179 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2026 Werner Schweer
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#include <QtTest/QtTest>
+#include <random>
+#include "mtest/testutils.h"
+#include "libmscore/score.h"
+#include "omr/pattern.h"
+
+#define DIR QString("omr/notes/")
+
+using namespace Ms;
+
+//---------------------------------------------------------
+//   ModelPattern
+//    pattern with a random model
+//---------------------------------------------------------
+
+class ModelPattern : public Pattern {
+   public:
+      ModelPattern(int r, int c, std::mt19937& rng)
+            {
+            rows  = r;
+            cols  = c;
+            model = new float*[rows];
+            std::uniform_real_distribution<float> dist(0.0f, 1.0f);
+            for (int y = 0; y < rows; ++y) {
+                  model[y] = new float[cols];
+                  for (int x = 0; x < cols; ++x)
+                        model[y][x] = dist(rng);
+                  }
+            // values which are clamped by match()
+            model[0][0] = 0.0f;
+            model[rows - 1][cols - 1] = 1.0f;
+            initModelTables();
+            }
+      ~ModelPattern()
+            {
+            for (int y = 0; y < rows; ++y)
+                  delete[] model[y];
+            delete[] model;
+            }
+
+      //---------------------------------------------------
+      //   referenceMatch
+      //    per pixel computation of Pattern::match()
+      //---------------------------------------------------
+
+      double referenceMatch(const QImage* img, int col, int row, double bg_parm) const
+            {
+            bg_parm = qBound(0.00001, bg_parm, 0.99999);
+            double log_bg_black = log(bg_parm);
+            double log_bg_white = log(1.0 - bg_parm);
+            double k = 0;
+            for (int y = 0; y < rows; ++y) {
+                  for (int x = 0; x < cols; x++) {
+                        if (col + x >= img->width() || row + y >= img->height())
+                              continue;
+                        bool black = qGray(img->pixel(col + x, row + y)) < 125;
+                        double bs_scr = qBound(0.00001, double(model[y][x]), 0.99999);
+                        k += black ? log(bs_scr) - log_bg_black : log(1.0 - bs_scr) - log_bg_white;
+                        }
+                  }
+            return k;
+            }
+      };
+
+//---------------------------------------------------------
+//   TestPattern
+//---------------------------------------------------------
+
+class TestPattern : public QObject, public MTest
+      {
+      Q_OBJECT
+
+   private slots:
+      void initTestCase();
+      void matchBitPlane_data();
+      void matchBitPlane();
+      void benchmarkPdfImport();
+      };
+
+//---------------------------------------------------------
+//   initTestCase
+//---------------------------------------------------------
+
+void TestPattern::initTestCase()
+      {
+      initMTest();
+      }
+
+//---------------------------------------------------------
+//   matchBitPlane
+//    Pattern::match() on the packed bit plane gives the
+//    same score as the per pixel formula, for pattern widths
+//    and positions which are not multiples of 32 and for
+//    patterns reaching over the right and bottom image edge
+//---------------------------------------------------------
+
+void TestPattern::matchBitPlane_data()
+      {
+      QTest::addColumn<int>("cols");
+      QTest::addColumn<int>("col");
+      QTest::addColumn<int>("row");
+      QTest::addColumn<bool>("inverted");
+
+      QTest::newRow("w7")         << 7  << 3   << 2  << false;
+      QTest::newRow("w31")        << 31 << 1   << 0  << false;
+      QTest::newRow("w32")        << 32 << 0   << 5  << false;
+      QTest::newRow("w32-shift")  << 32 << 13  << 5  << false;
+      QTest::newRow("w33")        << 33 << 31  << 7  << false;
+      QTest::newRow("w45")        << 45 << 50  << 11 << false;
+      QTest::newRow("w70")        << 70 << 17  << 3  << false;
+      QTest::newRow("right-edge") << 45 << 90  << 4  << false;
+      QTest::newRow("bottom")     << 33 << 40  << 30 << false;
+      QTest::newRow("inverted")   << 45 << 29  << 9  << true;
+      }
+
+void TestPattern::matchBitPlane()
+      {
+      QFETCH(int, cols);
+      QFETCH(int, col);
+      QFETCH(int, row);
+      QFETCH(bool, inverted);
+
+      std::mt19937 rng(cols * 1000 + col);
+      ModelPattern pattern(13, cols, rng);
+
+      QImage image(101, 37, QImage::Format_MonoLSB);
+      QVector<QRgb> ct(2);
+      ct[0] = inverted ? qRgb(0, 0, 0) : qRgb(255, 255, 255);
+      ct[1] = inverted ? qRgb(255, 255, 255) : qRgb(0, 0, 0);
+      image.setColorTable(ct);
+      std::bernoulli_distribution black(0.3);
+      for (int y = 0; y < image.height(); ++y) {
+            for (int x = 0; x < image.width(); ++x)
+                  image.setPixel(x, y, black(rng) ? 1 : 0);
+            }
+
+      for (double bg : { 0.1, 0.5, 0.0, 1.0 }) {
+            double ref = pattern.referenceMatch(&image, col, row, bg);
+            double val = pattern.match(&image, col, row, bg);
+            QVERIFY2(qAbs(val - ref) <= 1e-9 * qMax(1.0, qAbs(ref)),
+               qPrintable(QString("bg %1: %2 != %3").arg(bg).arg(val).arg(ref)));
+            }
+      }
+
+//---------------------------------------------------------
+//   benchmarkPdfImport
+//    one page through OMR, dominated by pattern matching
+//---------------------------------------------------------
+
+void TestPattern::benchmarkPdfImport()
+      {
+      MasterScore* score = readScore(DIR + "notes1.mscx");
+      QVERIFY(score);
+      score->doLayout();
+      savePdf(score, "notes1-benchmark.pdf");
+      delete score;
+
+      QBENCHMARK {
+            Score* score1 = readCreatedScore("notes1-benchmark.pdf");
+            QVERIFY(score1);
+            delete score1;
+            }
+      }
+
+QTEST_MAIN(TestPattern)
+#include "tst_pattern.moc"
+
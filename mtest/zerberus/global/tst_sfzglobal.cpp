@@ -58,6 +58,9 @@ void TestSfzGlobal::testglobal()
       QCOMPARE(synth->instrument(0)->zones().back()->keyLo, (char) 60);
       QCOMPARE(synth->instrument(0)->zones().back()->keyHi, (char) 70);
       QCOMPARE(synth->instrument(0)->zones().back()->keyBase, (char) 40);
+      // both regions use the same sample file, it is read only once
+      QVERIFY(synth->instrument(0)->zones().front()->sample);
+      QCOMPARE(synth->instrument(0)->zones().front()->sample, synth->instrument(0)->zones().back()->sample);
       }
 
 QTEST_MAIN(TestSfzGlobal)
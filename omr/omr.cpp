@@ -152,21 +152,12 @@ bool Omr::readPdf()
       _ocr->init();
 #endif
       int ID = READ_PDF;
-      int page = 0;
-      bool val;
       while (ID < ACTION_NUM) {
-            if(ID != INIT_PAGE && ID != SYSTEM_IDENTIFICATION) {
-                  page = 0;
-                  progress->setLabelText(QWidget::tr("%1 at Page %2").arg(ActionNames.at(ID+1)).arg(1));
-                  val = omrActions(ID, page);
-                  }
-            else {
-                  progress->setLabelText(QWidget::tr("%1 at Page %2").arg(ActionNames.at(ID)).arg(page+1));
-                  val = omrActions(ID, page);
-                  page++;
-                  }
+            progress->setLabelText(ActionNames.at(ID));
+            bool val = omrActions(ID);
 
             if (!val || progress->wasCanceled()) {
+                  waitForPages();
                   progress->close();
                   return false;
                   }
@@ -187,7 +178,7 @@ bool Omr::readPdf()
 //   actions
 //---------------------------------------------------------
 
-bool Omr::omrActions(int &ID, int page)
+bool Omr::omrActions(int &ID)
       {
       if(ID == READ_PDF) {
             _doc = new Pdf();
@@ -196,34 +187,31 @@ bool Omr::omrActions(int &ID, int page)
                   _doc = 0;
                   return false;
                   }
+            _spatium = 15.0; //constant spatium, image will be rescaled according to this parameter
+
+            //
+            // pages are rendered one by one, binarization and
+            // INIT_PAGE run concurrently for the rendered pages
+            //
             int n = _doc->numPages();
 //printf("readPdf: %d pages\n", n);
             for (int i = 0; i < n; ++i) {
                   OmrPage* page1 = new OmrPage(this);
-                  QImage image = _doc->page(i);
-                  if (image.isNull())
+                  QImage image = _doc->render(i);
+                  if (image.isNull()) {
+                        delete page1;
                         return false;
-                  page1->setImage(image);
+                        }
                   _pages.append(page1);
+                  _pageFutures.append(QtConcurrent::run(this, &Omr::initPage, page1, image));
                   }
 
-            _spatium = 15.0; //constant spatium, image will be rescaled according to this parameter
             ID++;
             return true;
             }
       else if(ID == INIT_PAGE) {
-            //load one page and rescale
-            _pages[page]->read();
-
-            //do the rescaling here
-            int new_w = _pages[page]->image().width() * _spatium/_pages[page]->spatium();
-            int new_h = _pages[page]->image().height() * _spatium/_pages[page]->spatium();
-            QImage image = _pages[page]->image().scaled(new_w,new_h, Qt::KeepAspectRatio);
-            _pages[page]->setImage(image);
-            _pages[page]->read();
-
-            if(page == _pages.size()-1)
-                  ID++;
+            waitForPages();
+            ID++;
             return true;
             }
       else if(ID == FINALIZE_PARMS) {
@@ -258,13 +246,44 @@ bool Omr::omrActions(int &ID, int page)
 
             }
       else if(ID == SYSTEM_IDENTIFICATION) {
-            _pages[page]->identifySystems();
-            if(page == _pages.size()-1) ID++;
+            // pages are independent, _pages keeps the page order
+            QtConcurrent::blockingMap(_pages, [](OmrPage* p) { p->identifySystems(); });
+            ID++;
             return true;
             }
       return false;
       }
 
+//---------------------------------------------------------
+//   initPage
+//    binarize, load and rescale one page;
+//    runs in a worker thread
+//---------------------------------------------------------
+
+void Omr::initPage(OmrPage* page, const QImage& image)
+      {
+      page->setImage(Pdf::binarization(image));
+      page->read();
+
+      //do the rescaling here
+      int new_w = page->image().width() * _spatium/page->spatium();
+      int new_h = page->image().height() * _spatium/page->spatium();
+      QImage scaled = page->image().scaled(new_w,new_h, Qt::KeepAspectRatio);
+      page->setImage(scaled);
+      page->read();
+      }
+
+//---------------------------------------------------------
+//   waitForPages
+//---------------------------------------------------------
+
+void Omr::waitForPages()
+      {
+      for (QFuture<void>& f : _pageFutures)
+            f.waitForFinished();
+      _pageFutures.clear();
+      }
+
 //---------------------------------------------------------
 //   spatiumMM
 //---------------------------------------------------------
@@ -52,6 +52,10 @@ class Omr {
       static void initUtils();
 
       void process1(int page);
+      void initPage(OmrPage*, const QImage&);
+
+      QList<QFuture<void>> _pageFutures;        // pages in work, see READ_PDF
+      void waitForPages();
 
 
       enum ActionID { READ_PDF, INIT_PAGE, FINALIZE_PARMS, SYSTEM_IDENTIFICATION, ACTION_NUM};
@@ -104,7 +108,7 @@ public:
       const QString& path() const {
             return _path;
             }
-      bool omrActions(int &ID, int page = 0);
+      bool omrActions(int &ID);
 
       static Pattern* quartheadPattern;
       static Pattern* halfheadPattern;
@@ -31,6 +31,7 @@
 #include "libmscore/sym.h"
 #include "libmscore/note.h"
 #include "pattern.h"
+#include <QtEndian>
 
 namespace Ms {
     //static const double noteTH = 1.0;
@@ -1600,17 +1601,21 @@ void OmrPage::getStaffLines()
 
 void OmrPage::getRatio()
       {
-      double num_black;
-      double num_white;
+      double num_black = 1;
+      double num_white = 1;
       _ratio = 0.0;
 
-      num_black = 1;
-      num_white = 1;
-      for (int x = 0; x < width(); ++x) {
-            for (int y = 0; y < height(); ++y) {
-                  if(isBlack(x,y)) num_black++;
-                  else num_white++;
-                  }
+      const int n = width() / 32;
+      const int r = width() % 32;
+      for (int y = 0; y < height(); ++y) {
+            const uint* p = scanLine(y);
+            int k = 0;
+            for (int i = 0; i < n; ++i)
+                  k += qPopulationCount(p[i]);
+            if (r)      // first pixel in bit 0 of the first byte
+                  k += qPopulationCount(qFromLittleEndian<quint32>(reinterpret_cast<const uchar*>(p + n)) & ((1u << r) - 1));
+            num_black += k;
+            num_white += width() - k;
             }
       _ratio = num_black / (num_black + num_white);
       }
@@ -22,6 +22,7 @@
 #include "libmscore/sym.h"
 #include "omr.h"
 #include <math.h>
+#include <QtEndian>
 
 namespace Ms {
 
@@ -72,69 +73,95 @@ double Pattern::match(const QImage*, int , int) const
     return 0.0;
     }
 
+//---------------------------------------------------------
+//   bitsAt
+//    return pixels x ... x + n - 1 (n <= 32) of a MonoLSB
+//    scan line, first pixel in bit 0; bits above n are
+//    not masked. MonoLSB has the first pixel in bit 0 of
+//    the first byte, so words are read little endian.
+//---------------------------------------------------------
+
+static inline uint bitsAt(const uchar* line, int x, int n)
+      {
+      const uchar* p  = line + ((x >> 5) << 2);
+      const int shift = x & 31;
+      uint v = qFromLittleEndian<quint32>(p) >> shift;
+      if (shift + n > 32)
+            v |= qFromLittleEndian<quint32>(p + 4) << (32 - shift);
+      return v;
+      }
+
+//---------------------------------------------------------
+//   match
+//    log likelihood ratio of the model against the
+//    background at col/row of a binarized (MonoLSB) image;
+//    pixels outside of the image are ignored
+//
+//    sum of (black ? log(p) : log(1 - p)) is computed as
+//    sum of log(1 - p) over all pixels, taken from the row
+//    prefix sums, plus log(p) - log(1 - p) of black pixels
+//---------------------------------------------------------
+
 double Pattern::match(const QImage* img, int col, int row, double bg_parm) const
       {
-#if 0
-      double scr = 0;
-      for (int y = 0; y < rows; ++y) {
-            for (int x = 0; x < cols; x++) {
-                  if(col+x >= img->size().width() || row+y >= img->size().height()) continue;
-                  QRgb c = img->pixel(col+x, row+y);
-                  bool black = (qGray(c) < 125);
-                  scr += black ? 1 : 0;
-                  }
-            }
-      return scr;
-#endif
-      double k = 0;
-      
-      //return k;
+      Q_ASSERT(img->format() == QImage::Format_MonoLSB);
+
       if (bg_parm < 0.00001)
             bg_parm = 0.00001;
       if (bg_parm > 0.99999)
             bg_parm = 0.99999;
-            
-      double log_bg_black = log(bg_parm);
-      double log_bg_white = log(1.0-bg_parm);
-      
-      for (int y = 0; y < rows; ++y) {
-            for (int x = 0; x < cols; x++) {
-                  if (col+x >= img->size().width() || row+y >= img->size().height())
-                        continue;
-                  QRgb c = img->pixel(col+x, row+y);
-                  bool black = (qGray(c) < 125);
-
-                  double bs_scr = model[y][x];
-                  if (bs_scr < 0.00001)
-                        bs_scr = 0.00001;
-                  if (bs_scr > 0.99999)
-                        bs_scr = 0.99999;
-                  
-                  double log_black = log(bs_scr) - log_bg_black;
-                  double log_white = log(1.0 - bs_scr) - log_bg_white;
-                  
-                  k += black?log_black:log_white;
-                  
+
+      const double log_bg_black = log(bg_parm);
+      const double log_bg_white = log(1.0 - bg_parm);
+
+      const int x1 = qMax(col, 0);
+      const int x2 = qMin(col + cols, img->width());
+      const int y1 = qMax(row, 0);
+      const int y2 = qMin(row + rows, img->height());
+      if (x1 >= x2 || y1 >= y2)
+            return 0.0;
+                  // a set bit is a black pixel unless the color table is inverted
+      const uint invert = qGray(img->color(1)) < 125 ? 0 : 0xffffffff;
+
+      double k = 0.0;
+      int blackCount = 0;
+      for (int y = y1; y < y2; ++y) {
+            const uchar* line = img->constScanLine(y);
+            const int wOffset = (y - row) * cols - col;
+            const int sOffset = (y - row) * (cols + 1) - col;
+            k += _whiteSum[sOffset + x2] - _whiteSum[sOffset + x1];
+            for (int x = x1; x < x2; x += 32) {
+                  const int n = qMin(32, x2 - x);
+                  uint bits = bitsAt(line, x, n) ^ invert;
+                  if (n < 32)
+                        bits &= (1u << n) - 1;
+                  blackCount += qPopulationCount(bits);
+                  for (; bits; bits &= bits - 1)
+                        k += _blackWeight[wOffset + x + qCountTrailingZeroBits(bits)];
                   }
             }
-      return k;
-#if 0
-      for (int x = 0; x < bytes; ++x) {
-            uchar a = *p1++;
-            uchar b1 = *p2;
-            uchar b2 = *(p2 + 1);
-            p2++;
-            uchar b  = (b1 >> shift) | (b2 << (7 - shift));
-            uchar v = a ^ b;
-            k += Omr::bitsSetTable[v];
+      const int count = (x2 - x1) * (y2 - y1);
+      return k - count * log_bg_white - blackCount * (log_bg_black - log_bg_white);
+      }
+
+//---------------------------------------------------------
+//   initModelTables
+//---------------------------------------------------------
+
+void Pattern::initModelTables()
+      {
+      _blackWeight.resize(rows * cols);
+      _whiteSum.resize(rows * (cols + 1));
+      for (int y = 0; y < rows; ++y) {
+            double sum = 0.0;
+            _whiteSum[y * (cols + 1)] = sum;
+            for (int x = 0; x < cols; ++x) {
+                  const double p = qBound(0.00001, double(model[y][x]), 0.99999);
+                  _blackWeight[y * cols + x] = log(p) - log(1.0 - p);
+                  sum += log(1.0 - p);
+                  _whiteSum[y * (cols + 1) + x + 1] = sum;
+                  }
             }
-      uchar a = *p1++;
-      uchar b1 = *p2;
-      uchar b2 = *(p2 + 1) & (0xff << eshift);
-      uchar b  = (b1 >> shift) | (b2 << (7 - shift));
-      uchar v = a ^ b;
-      k += Omr::bitsSetTable[v];
-#endif
       }
 
 //---------------------------------------------------------
@@ -203,6 +230,7 @@ Pattern::Pattern(Score *s, QString name)
                   for(int j = 0; j < cols; j++)
                         in >> model[i][j];
                   }
+            initModelTables();
             }
       f.close();
       }
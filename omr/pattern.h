@@ -41,6 +41,12 @@ class Pattern {
       float **model;
       int rows;
       int cols;
+                  // model tables, row major:
+                  // log(p) - log(1 - p) per pixel, and per row prefix sums of log(1 - p)
+      std::vector<double> _blackWeight;
+      std::vector<double> _whiteSum;
+
+      void initModelTables();
 
    public:
       Pattern();
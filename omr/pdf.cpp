@@ -71,7 +71,7 @@ Pdf::~Pdf()
 //   binarization
 //---------------------------------------------------------
 
-QImage Pdf::binarization(QImage image){
+QImage Pdf::binarization(const QImage& image){
       QImage bw = QImage(image.width(), image.height(), QImage::Format_MonoLSB);
       QVector<QRgb> ct(2);
       ct[0] = qRgb(255, 255, 255);
@@ -126,9 +126,24 @@ QImage Pdf::binarization(QImage image){
 
 //---------------------------------------------------------
 //   page
+//    rendered and binarized page
 //---------------------------------------------------------
 
 QImage Pdf::page(int i)
+      {
+      QImage image = render(i);
+      if (image.isNull())
+            return image;
+      return binarization(image);
+      }
+
+//---------------------------------------------------------
+//   render
+//    poppler document is not thread safe, render pages
+//    from one thread only; binarization can run in parallel
+//---------------------------------------------------------
+
+QImage Pdf::render(int i)
       {
       QImage image;
       // Paranoid safety check
@@ -146,7 +161,7 @@ QImage Pdf::page(int i)
       // the size can be decided more intelligently
       image = pdfPage->renderToImage(scale*72.0, scale*72.0, 0, 0, scale*size.width(), scale*size.height());
       delete pdfPage;
-      return binarization(image);
+      return image;
       }
 }
 
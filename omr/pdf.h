@@ -43,7 +43,8 @@ class Pdf {
 
       int numPages() const;
       QImage page(int);
-      QImage binarization(QImage image);
+      QImage render(int);
+      static QImage binarization(const QImage& image);
       };
 }
 
@@ -84,6 +84,21 @@ void MasterSynthesizer::reset()
             s->reset();
       }
 
+//---------------------------------------------------------
+//   voiceCount
+//    number of sounding voices of all active synthesizers
+//---------------------------------------------------------
+
+int MasterSynthesizer::voiceCount() const
+      {
+      int n = 0;
+      for (Synthesizer* s : _synthesizer) {
+            if (s->active())
+                  n += s->voiceCount();
+            }
+      return n;
+      }
+
 //---------------------------------------------------------
 //   play
 //---------------------------------------------------------
@@ -82,6 +82,7 @@ class MasterSynthesizer : public QObject {
       void setSampleRate(float val);
 
       void process(unsigned, float*);
+      int voiceCount() const;
       void play(const NPlayEvent&, unsigned);
 
       void setMasterTuning(double val);
@@ -79,6 +79,7 @@ class Synthesizer {
 
       virtual void allSoundsOff(int /*channel*/) {}
       virtual void allNotesOff(int /*channel*/) {}
+      virtual int voiceCount() const { return 0; }      // sounding voices, called from the audio thread
 
       virtual SynthesizerGui* gui()  { return _gui; }
       };
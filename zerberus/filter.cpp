@@ -274,6 +274,135 @@ float ZFilter::apply(float inputValue, bool leftChannel)
       return value;
       }
 
+//---------------------------------------------------------
+//   filter equations for block processing,
+//   same as in apply(float, bool)
+//---------------------------------------------------------
+
+inline float ZFilter::applyBq(float x, FilterData& d)
+      {
+      float value = b0 * x + b1 * d.histX1 + b2 * d.histX2 + a1 * d.histY1 + a2 * d.histY2;
+      d.histX2 = d.histX1;
+      d.histX1 = x;
+      d.histY2 = d.histY1;
+      d.histY1 = value;
+      return value;
+      }
+
+inline float ZFilter::applyHPF1P(float x, FilterData& d)
+      {
+      float value = b0 * x + b1 * d.histX1 - a1 * d.histY1;
+      d.histX1 = x;
+      d.histY1 = value;
+      return value;
+      }
+
+inline float ZFilter::applyLPF1P(float x, FilterData& d)
+      {
+      float value = b0 * x - a1 * d.histY1;
+      d.histY1 = value;
+      return value;
+      }
+
+inline void ZFilter::stepCoefficients()
+      {
+      if (filter_coeff_incr_count) {
+            --filter_coeff_incr_count;
+            a1 += a1_incr;
+            a2 += a2_incr;
+            b0 += b0_incr;
+            b1 += b1_incr;
+            b2 += b2_incr;
+            }
+      }
+
+//---------------------------------------------------------
+//   apply
+//    filter n mono values in place
+//---------------------------------------------------------
+
+void ZFilter::apply(float* values, int n)
+      {
+      switch (sampleZone->fil_type) {
+            case FilterType::hpf_2p:
+            case FilterType::lpf_2p:
+            case FilterType::bpf_2p:
+            case FilterType::brf_2p:
+                  for (int i = 0; i < n; ++i) {
+                        values[i] = applyBq(values[i], monoL);
+                        stepCoefficients();
+                        }
+                  break;
+            case FilterType::hpf_1p:
+                  for (int i = 0; i < n; ++i) {
+                        values[i] = applyHPF1P(values[i], monoL);
+                        stepCoefficients();
+                        }
+                  break;
+            case FilterType::lpf_1p:
+                  for (int i = 0; i < n; ++i) {
+                        values[i] = applyLPF1P(values[i], monoL);
+                        stepCoefficients();
+                        }
+                  break;
+            default:
+                  qWarning() << "this equation is not implemented" << (int)sampleZone->fil_type;
+                  for (int i = 0; i < n; ++i) {
+                        values[i] = 0.f;
+                        stepCoefficients();
+                        }
+                  break;
+            }
+      }
+
+//---------------------------------------------------------
+//   apply
+//    filter n stereo frames in place; like apply(float, bool)
+//    the coefficients advance once per channel
+//---------------------------------------------------------
+
+void ZFilter::apply(float* left, float* right, int n)
+      {
+      switch (sampleZone->fil_type) {
+            case FilterType::hpf_2p:
+            case FilterType::lpf_2p:
+            case FilterType::bpf_2p:
+            case FilterType::brf_2p:
+                  for (int i = 0; i < n; ++i) {
+                        left[i] = applyBq(left[i], monoL);
+                        stepCoefficients();
+                        right[i] = applyBq(right[i], monoR);
+                        stepCoefficients();
+                        }
+                  break;
+            case FilterType::hpf_1p:
+                  for (int i = 0; i < n; ++i) {
+                        left[i] = applyHPF1P(left[i], monoL);
+                        stepCoefficients();
+                        right[i] = applyHPF1P(right[i], monoR);
+                        stepCoefficients();
+                        }
+                  break;
+            case FilterType::lpf_1p:
+                  for (int i = 0; i < n; ++i) {
+                        left[i] = applyLPF1P(left[i], monoL);
+                        stepCoefficients();
+                        right[i] = applyLPF1P(right[i], monoR);
+                        stepCoefficients();
+                        }
+                  break;
+            default:
+                  qWarning() << "this equation is not implemented" << (int)sampleZone->fil_type;
+                  for (int i = 0; i < n; ++i) {
+                        left[i]  = 0.f;
+                        right[i] = 0.f;
+                        stepCoefficients();
+                        stepCoefficients();
+                        }
+                  break;
+            }
+      }
+
 //---------------------------------------------------------
 //   interpolate
 //---------------------------------------------------------
@@ -29,6 +29,8 @@ public:
 
       void update();
       float apply(float inputValue, bool leftChannel);
+      void apply(float* values, int n);                   // mono block
+      void apply(float* left, float* right, int n);       // stereo block
       float interpolate(unsigned phase, short prevVal, short currVal, short nextVal, short nextNextVal) const; //pure function
 
 private:
@@ -56,6 +58,11 @@ private:
       FilterData monoL;
       FilterData monoR;
 
+      inline float applyBq(float x, FilterData& d);
+      inline float applyHPF1P(float x, FilterData& d);
+      inline float applyLPF1P(float x, FilterData& d);
+      inline void stepCoefficients();
+
       // normalized filter coefficients (bX = bX/a0 and aX = aX/a0)
       // see Robert Bristow-Johnson's 'Cookbook formulae for audio EQ biquad filter coefficients'
       float b0 = 0.f;              // b0 / a0
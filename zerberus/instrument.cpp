@@ -15,33 +15,86 @@
 #include <QFile>
 #include <QFileInfo>
 #include <QStringList>
+#include <QSaveFile>
+#include <QDir>
+#include <QDateTime>
+#include <QCryptographicHash>
+#include <QStandardPaths>
 
 #include "libmscore/xml.h"
 #include "audiofile/audiofile.h"
+#include "mscore/preferences.h"
 #include "thirdparty/qzip/qzipreader_p.h"
 
 #include "instrument.h"
 #include "zone.h"
 #include "sample.h"
 
-QByteArray ZInstrument::buf;
-int ZInstrument::idx;
-
 //---------------------------------------------------------
 //   Sample
 //---------------------------------------------------------
 
 Sample::~Sample()
       {
-      delete[] _data;
+      if (_cacheFile)
+            delete _cacheFile;      // also unmaps the data
+      else
+            delete[] _data;
       }
 
+//---------------------------------------------------------
+//   moveToCache
+//    use data mapped from the sample cache file f instead
+//    of the data in memory, the sample takes ownership
+//    of f
+//---------------------------------------------------------
+
+void Sample::moveToCache(QFile* f, short* data)
+      {
+      if (!_cacheFile)
+            delete[] _data;
+      _data      = data;
+      _cacheFile = f;
+      }
+
+//---------------------------------------------------------
+//   SampleCacheHeader
+//    start of a sample cache file, the padded sample data
+//    follows at SAMPLE_CACHE_DATA; the files are only
+//    read on the machine that wrote them
+//---------------------------------------------------------
+
+static const quint32 SAMPLE_CACHE_MAGIC = 0x5a534331;    // "ZSC1"
+static const qint64 SAMPLE_CACHE_DATA   = 64;
+
+struct SampleCacheHeader {
+      quint32 magic;
+      qint32 channel;
+      qint64 frames;
+      qint32 sampleRate;
+      qint32 loopMode;
+      qint64 loopStart;
+      qint64 loopEnd;
+      };
+
 //---------------------------------------------------------
 //   readSample
+//    can be called from several threads at once
 //---------------------------------------------------------
 
 Sample* ZInstrument::readSample(const QString& s, MQZipReader* uz)
       {
+      QString cachePath;
+      if (_preloadMs >= 0) {
+            cachePath = sampleCachePath(s, uz != 0);
+            if (!cachePath.isEmpty()) {
+                  Sample* sa = readCachedSample(cachePath);
+                  if (sa)
+                        return sa;
+                  }
+            }
+
+      QByteArray buf;
       if (uz) {
             QVector<MQZipReader::FileInfo> fi = uz->fileInfoList();
 
@@ -79,16 +132,169 @@ Sample* ZInstrument::readSample(const QString& s, MQZipReader* uz)
       if (frames != a.readData(data + channel, frames)) {
             qDebug("Sample read failed: %s\n", a.error());
             delete sa;
-            sa = 0;
+            return 0;
             }
       for (int i = 0; i < channel; ++i) {
             data[i]                        = data[channel + i];
             data[(frames-1) * channel + i] = data[(frames-3) * channel + i];
             data[(frames-2) * channel + i] = data[(frames-3) * channel + i];
             }
+      //
+      // in disk streaming mode long samples are kept in the
+      // sample cache and only their first milliseconds in
+      // memory, see mapSampleCache()
+      //
+      if (!cachePath.isEmpty()) {
+            const long long preloadFrames = (long long)_preloadMs * sr / 1000;
+            if (frames > preloadFrames)
+                  moveToSampleCache(sa, cachePath);
+            }
       return sa;
       }
 
+//---------------------------------------------------------
+//   sampleCachePath
+//    cache file of sample s, the name depends on the
+//    sample file (or the archive of the instrument) and
+//    its modification time, so that a changed file is
+//    decoded again
+//---------------------------------------------------------
+
+QString ZInstrument::sampleCachePath(const QString& s, bool inArchive) const
+      {
+      QFileInfo fi(inArchive ? instrumentPath : s);
+      if (_sampleCacheDir.isEmpty() || !fi.exists())
+            return QString();
+      QCryptographicHash h(QCryptographicHash::Sha1);
+      h.addData(fi.canonicalFilePath().toUtf8());
+      if (inArchive)
+            h.addData(("\n" + s).toUtf8());
+      h.addData("\n" + QByteArray::number(fi.lastModified().toMSecsSinceEpoch()));
+      h.addData("\n" + QByteArray::number(fi.size()));
+      return _sampleCacheDir + "/" + QString::fromLatin1(h.result().toHex()) + ".raw";
+      }
+
+//---------------------------------------------------------
+//   readCachedSample
+//    return 0 if there is no valid cache file, the sample
+//    is then decoded again
+//---------------------------------------------------------
+
+Sample* ZInstrument::readCachedSample(const QString& cachePath)
+      {
+      QFile* f = new QFile(cachePath);
+      if (!f->open(QIODevice::ReadOnly)) {
+            delete f;
+            return 0;
+            }
+      SampleCacheHeader h;
+      if (f->read(reinterpret_cast<char*>(&h), sizeof(h)) != qint64(sizeof(h))
+         || h.magic != SAMPLE_CACHE_MAGIC || h.channel <= 0 || h.frames <= 0
+         || f->size() != SAMPLE_CACHE_DATA + (h.frames + 3) * h.channel * qint64(sizeof(short))) {
+            qDebug("invalid sample cache file %s", qPrintable(cachePath));
+            delete f;
+            return 0;
+            }
+#if QT_VERSION >= QT_VERSION_CHECK(5, 10, 0)
+      // the modification time is the last use for pruneSampleCache()
+      f->setFileTime(QDateTime::currentDateTime(), QFileDevice::FileModificationTime);
+#endif
+      Sample* sa = new Sample(h.channel, 0, h.frames, h.sampleRate);
+      sa->setLoopStart(h.loopStart);
+      sa->setLoopEnd(h.loopEnd);
+      sa->setLoopMode(h.loopMode);
+      if (!mapSampleCache(sa, f)) {
+            delete sa;
+            return 0;
+            }
+      return sa;
+      }
+
+//---------------------------------------------------------
+//   moveToSampleCache
+//    write the sample data to its cache file and replace
+//    it by the mapped file; the sample stays in memory
+//    on error. Instruments loaded in parallel may write
+//    the same file, QSaveFile replaces it atomically.
+//---------------------------------------------------------
+
+bool ZInstrument::moveToSampleCache(Sample* s, const QString& cachePath)
+      {
+      SampleCacheHeader h;
+      h.magic      = SAMPLE_CACHE_MAGIC;
+      h.channel    = s->channel();
+      h.frames     = s->frames();
+      h.sampleRate = s->sampleRate();
+      h.loopMode   = s->loopMode();
+      h.loopStart  = s->loopStart();
+      h.loopEnd    = s->loopEnd();
+      QByteArray header(SAMPLE_CACHE_DATA, 0);
+      memcpy(header.data(), &h, sizeof(h));
+
+      QSaveFile sf(cachePath);
+      const qint64 n = s->size() * qint64(sizeof(short));
+      if (!sf.open(QIODevice::WriteOnly)
+         || sf.write(header) != header.size()
+         || sf.write(reinterpret_cast<const char*>(s->rawData()), n) != n
+         || !sf.commit()) {
+            qDebug("cannot write sample cache %s: %s", qPrintable(cachePath), qPrintable(sf.errorString()));
+            return false;
+            }
+      QFile* f = new QFile(cachePath);
+      if (!f->open(QIODevice::ReadOnly)) {
+            delete f;
+            return false;
+            }
+      return mapSampleCache(s, f);
+      }
+
+//---------------------------------------------------------
+//   mapSampleCache
+//    map the sample data of the cache file f into memory,
+//    the system pages it in on demand; the first
+//    milliseconds are touched now to have the note start
+//    in memory. The sample takes ownership of f.
+//---------------------------------------------------------
+
+bool ZInstrument::mapSampleCache(Sample* s, QFile* f)
+      {
+      uchar* base = f->map(SAMPLE_CACHE_DATA, s->size() * qint64(sizeof(short)));
+      if (!base) {
+            qDebug("cannot map sample cache: %s", qPrintable(f->errorString()));
+            delete f;
+            return false;
+            }
+      s->moveToCache(f, reinterpret_cast<short*>(base));
+
+      const long long n = std::min(s->size(), ((long long)_preloadMs * s->sampleRate() / 1000 + 1) * s->channel());
+      const short* d    = s->rawData();
+      volatile short touch = 0;
+      for (long long i = 0; i < n; i += 2048)    // one read per 4k page
+            touch = touch + d[i];
+      return true;
+      }
+
+//---------------------------------------------------------
+//   pruneSampleCache
+//    remove the least recently used cache files until the
+//    cache is smaller than maxSize. Files of changed or
+//    removed sample libraries are not used anymore and go
+//    first. Files still mapped by a loaded instrument are
+//    unlinked on Unix; elsewhere they cannot be removed
+//    and are skipped.
+//---------------------------------------------------------
+
+void ZInstrument::pruneSampleCache(const QString& dir, qint64 maxSize)
+      {
+      QFileInfoList files = QDir(dir).entryInfoList(QStringList("*.raw"), QDir::Files, QDir::Time);
+      qint64 size = 0;
+      for (const QFileInfo& fi : files) {       // newest first
+            size += fi.size();
+            if (size > maxSize)
+                  QFile::remove(fi.filePath());
+            }
+      }
+
 //---------------------------------------------------------
 //   ZInstrument
 //---------------------------------------------------------
@@ -110,6 +316,8 @@ ZInstrument::~ZInstrument()
       {
       for (Zone* z : _zones)
             delete z;
+      for (Sample* s : _samples)
+            delete s;
       }
 
 //---------------------------------------------------------
@@ -122,12 +330,25 @@ bool ZInstrument::load(const QString& path)
       instrumentPath = path;
       QFileInfo fi(path);
       _name = fi.completeBaseName();
+      // read the preferences here, samples are read in worker threads
+      _preloadMs = Ms::preferences.getBool(PREF_IO_ZERBERUS_DISKSTREAMING)
+         ? Ms::preferences.getInt(PREF_IO_ZERBERUS_PRELOADMS) : -1;
+      if (_preloadMs >= 0) {
+            // not the temp directory, which is often in memory
+            _sampleCacheDir = QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/zerberus";
+            if (!QDir().mkpath(_sampleCacheDir))
+                  _sampleCacheDir.clear();
+            else
+                  pruneSampleCache(_sampleCacheDir, qint64(Ms::preferences.getInt(PREF_IO_ZERBERUS_SAMPLECACHEMB)) * 1024 * 1024);
+            }
+      bool ok = false;
       if (fi.isFile())
-            return loadFromFile(path);
-      if (fi.isDir())
-            return loadFromDir(path);
-      qDebug("not file nor dir %s", qPrintable(path));
-      return false;
+            ok = loadFromFile(path);
+      else if (fi.isDir())
+            ok = loadFromDir(path);
+      else
+            qDebug("not file nor dir %s", qPrintable(path));
+      return ok;
       }
 
 //---------------------------------------------------------
@@ -14,6 +14,7 @@
 #define __MINSTRUMENT_H__
 
 #include <list>
+#include <vector>
 #include <QString>
 
 class Zerberus;
@@ -22,6 +23,7 @@ class MQZipReader;
 struct Zone;
 struct SfzRegion;
 class Sample;
+class QFile;
 
 //---------------------------------------------------------
 //   ZInstrument
@@ -34,12 +36,22 @@ class ZInstrument {
       int _program;
       QString instrumentPath;
       std::list<Zone*> _zones;
+      std::vector<Sample*> _samples;        // zones share samples of the same file
       int _setcc[128];
+      int _preloadMs = -1;                  // -1: no disk streaming
+      QString _sampleCacheDir;              // decoded data of disk backed samples, in
+                                            // <QStandardPaths::CacheLocation>/zerberus
 
       bool loadFromFile(const QString&);
       bool loadSfz(const QString&);
       bool loadFromDir(const QString&);
       bool read(const QByteArray&, MQZipReader*, const QString& path);
+      bool addRegions(std::vector<SfzRegion>&);
+      QString sampleCachePath(const QString& s, bool inArchive) const;
+      Sample* readCachedSample(const QString& cachePath);
+      bool moveToSampleCache(Sample*, const QString& cachePath);
+      bool mapSampleCache(Sample*, QFile*);
+      static void pruneSampleCache(const QString& dir, qint64 maxSize);
 
    public:
       ZInstrument(Zerberus*);
@@ -55,11 +67,8 @@ class ZInstrument {
       std::list<Zone*>& zones()             { return _zones;  }
       Sample* readSample(const QString& s, MQZipReader* uz);
       void addZone(Zone* z)                 { _zones.push_back(z); }
-      void addRegion(SfzRegion&);
+      void addRegion(SfzRegion&, Sample*);
       int getSetCC(int v)                   { return _setcc[v]; }
-
-      static QByteArray buf;  // used during read of Sample
-      static int idx;
       };
 
 #endif
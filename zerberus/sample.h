@@ -13,6 +13,8 @@
 #ifndef __SAMPLE_H__
 #define __SAMPLE_H__
 
+class QFile;
+
 //---------------------------------------------------------
 //   Sample
 //---------------------------------------------------------
@@ -25,6 +27,8 @@ class Sample {
       long long _loopStart;
       long long _loopEnd;
       int _loopMode;
+      QFile* _cacheFile = 0;        // mapped sample cache file _data points into
+                                    // if the data is disk backed
 
    public:
       Sample(int ch, short* val, int f, int sr)
@@ -33,6 +37,11 @@ class Sample {
       bool read(const QString&);
       long long frames() const     { return _frames;          }
       short* data() const    { return _data + _channel; }
+      short* rawData() const { return _data; }
+      long long size() const { return (_frames + 3) * _channel; }   // in shorts, with padding
+
+      bool isCached() const  { return _cacheFile != 0; }
+      void moveToCache(QFile* f, short* data);
       int channel() const    { return _channel;         }
       int sampleRate() const { return _sampleRate;      }
 
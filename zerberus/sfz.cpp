@@ -15,6 +15,11 @@
 #include <QFile>
 #include <QFileInfo>
 #include <QStringList>
+#include <QThread>
+#include <QCoreApplication>
+#include <QEventLoop>
+#include <QFutureWatcher>
+#include <QtConcurrent>
 #include <sndfile.h>
 
 #include "libmscore/xml.h"
@@ -24,6 +29,8 @@
 #include "sample.h"
 #include "zerberus.h"
 
+static const int SFZ_PARSE_PROGRESS = 10;    // load progress after parsing, the rest is sample decoding
+
 //---------------------------------------------------------
 //   SfzControl
 //---------------------------------------------------------
@@ -291,8 +298,10 @@ int SfzRegion::readKey(const QString& s, SfzControl c) const
 //   addRegion
 //---------------------------------------------------------
 
-void ZInstrument::addRegion(SfzRegion& r)
+void ZInstrument::addRegion(SfzRegion& r, Sample* sample)
       {
+      if (!sample)
+            return;
       for (int i = 0; i < 128; ++i) {
             if (r.on_locc[i] != -1 || r.on_hicc[i] != -1) {
                   r.trigger = Trigger::CC;
@@ -300,19 +309,73 @@ void ZInstrument::addRegion(SfzRegion& r)
                   }
             }
       Zone* z = new Zone;
-      z->sample = readSample(r.sample, 0);
-      if (z->sample) {
-            //qDebug("Sample Loop - start %ll, end %ll, mode %d", z->sample->loopStart(), z->sample->loopEnd(), z->sample->loopMode());
-            // if there is no opcode defining loop ranges, use sample definitions as fallback (according to spec)
-            if (r.loopStart == -1)
-                  r.loopStart = z->sample->loopStart();
-            if (r.loopEnd == -1)
-                  r.loopEnd = z->sample->loopEnd();
-            }
+      z->sample = sample;
+      //qDebug("Sample Loop - start %ll, end %ll, mode %d", z->sample->loopStart(), z->sample->loopEnd(), z->sample->loopMode());
+      // if there is no opcode defining loop ranges, use sample definitions as fallback (according to spec)
+      if (r.loopStart == -1)
+            r.loopStart = sample->loopStart();
+      if (r.loopEnd == -1)
+            r.loopEnd = sample->loopEnd();
       r.setZone(z);
-      if (z->sample)
-            addZone(z);
+      addZone(z);
+      }
+
+//---------------------------------------------------------
+//   addRegions
+//    decode the samples of all regions in parallel, every
+//    sample file is read only once and shared by all
+//    regions using it
+//---------------------------------------------------------
+
+bool ZInstrument::addRegions(std::vector<SfzRegion>& regions)
+      {
+      QStringList paths;
+      QHash<QString, int> pathIndex;
+      for (const SfzRegion& r : regions) {
+            if (!pathIndex.contains(r.sample)) {
+                  pathIndex.insert(r.sample, paths.size());
+                  paths.append(r.sample);
+                  }
+            }
+      std::vector<Sample*> samples(paths.size(), nullptr);
+      std::vector<int> indices(paths.size());
+      for (int i = 0; i < paths.size(); ++i)
+            indices[i] = i;
+
+      // progress and cancellation are handled as samples are
+      // finished; the signals of the watcher need an event loop
+      // in this thread, the gui thread just waits
+      QFutureWatcher<void> watcher;
+      QEventLoop loop;
+      QObject::connect(&watcher, &QFutureWatcher<void>::progressValueChanged, [this, &watcher](int value) {
+            if (zerberus->loadWasCanceled())
+                  watcher.cancel();
+            else if (watcher.progressMaximum() > 0)
+                  zerberus->setLoadProgress(SFZ_PARSE_PROGRESS
+                     + (100 - SFZ_PARSE_PROGRESS) * value / watcher.progressMaximum());
+            });
+      QObject::connect(&watcher, &QFutureWatcher<void>::finished, &loop, &QEventLoop::quit);
+      watcher.setFuture(QtConcurrent::map(indices, [this, &paths, &samples](int i) {
+            if (!zerberus->loadWasCanceled())
+                  samples[i] = readSample(paths[i], 0);
+            }));
+      QCoreApplication* app = QCoreApplication::instance();
+      if (app && QThread::currentThread() != app->thread() && !watcher.isFinished())
+            loop.exec();
+      watcher.waitForFinished();
+
+      for (Sample* s : samples) {
+            if (s)
+                  _samples.push_back(s);      // owned by the instrument from now on
+            }
+      if (zerberus->loadWasCanceled())
+            return false;
+      for (SfzRegion& r : regions)
+            addRegion(r, samples[pathIndex[r.sample]]);
+      zerberus->setLoadProgress(100);
+      return true;
       }
+
 //---------------------------------------------------------
 //   readLongLong
 //---------------------------------------------------------
@@ -701,17 +764,18 @@ bool ZInstrument::loadSfz(const QString& s)
 
       bool groupMode = false;
       bool globMode = false;
+      std::vector<SfzRegion> regions;
       zerberus->setLoadProgress(0);
 
       for (int idx1 = 0; idx1 < fileContents.size(); idx1++) {
             QString curLine = fileContents[idx1];
-            zerberus->setLoadProgress(((qreal) idx1 * 100) /  (qreal) total);
+            zerberus->setLoadProgress(((qreal) idx1 * SFZ_PARSE_PROGRESS) /  (qreal) total);
 
             if (zerberus->loadWasCanceled())
                   return false;
             if (curLine.startsWith("<global>")) {
                   if (!globMode && !groupMode && !r.isEmpty())
-                        addRegion(r);
+                        regions.push_back(r);
                   glob.init(path);
                   g.init(path); // global also resets group
                   r.init(path);
@@ -719,7 +783,7 @@ bool ZInstrument::loadSfz(const QString& s)
                   }
             if (curLine.startsWith("<group>")) {
                   if (!groupMode && !globMode && !r.isEmpty())
-                        addRegion(r);
+                        regions.push_back(r);
                   g.init(path);
                   if (globMode) {
                         glob = r;
@@ -743,7 +807,7 @@ bool ZInstrument::loadSfz(const QString& s)
                         }
                   else {
                         if (!r.isEmpty())
-                              addRegion(r);
+                              regions.push_back(r);
                         r = g;  // initialize next region with group values
                         }
                   curLine = curLine.mid(8);
@@ -772,9 +836,8 @@ bool ZInstrument::loadSfz(const QString& s)
       for (int i = 0; i < 128; i++)
             _setcc[i] = c.set_cc[i];
 
-      zerberus->setLoadProgress(100);
       if (!groupMode && !globMode && !r.isEmpty())
-            addRegion(r);
-      return true;
+            regions.push_back(r);
+      return addRegions(regions);
       }
 
@@ -23,6 +23,8 @@
 float Envelope::egPow[EG_SIZE];
 float Envelope::egLin[EG_SIZE];
 
+static const int BLOCK_SIZE = 64;     // max. frames rendered by Voice::processBlock()
+
 static const char* voiceStateNames[] = {
       "OFF", "ATTACK", "PLAYING", "SUSTAINED", "STOP"
       };
@@ -213,6 +215,9 @@ void Voice::updateEnvelopes() {
 
 //---------------------------------------------------------
 //   process
+//    frames are rendered in blocks up to the next loop
+//    point, end of sample or envelope stage change;
+//    the frames around such events are rendered one by one
 //---------------------------------------------------------
 
 void Voice::process(int frames, float* p)
@@ -223,71 +228,189 @@ void Voice::process(int frames, float* p)
       const float opcodePanRightGain = 1.f + std::fmin(0.0f, z->pan / 100.0); //[0, 1]
       const float leftChannelVol = gain * z->ccGain * _channel->panLeftGain() * opcodePanLeftGain;
       const float rightChannelVol = gain * z->ccGain * _channel->panRightGain() * opcodePanRightGain;
-      if (audioChan == 1) {
-            while (frames--) {
 
-                  updateLoop();
+      while (frames > 0) {
+            const int n = std::min(blockFrames(), frames);
+            if (n > 0) {
+                  processBlock(n, p, leftChannelVol, rightChannelVol);
+                  p      += n * 2;
+                  frames -= n;
+                  }
+            else {
+                  if (!processFrame(p, leftChannelVol, rightChannelVol))
+                        break;
+                  p += 2;
+                  --frames;
+                  }
+            }
+      }
 
-                  long long idx = phase.index();
+//---------------------------------------------------------
+//   blockFrames
+//    number of frames from the current position, which
+//    processBlock() can render: no loop wraparound or loop
+//    state change, no end of sample, no envelope stage change
+//    and no sample data outside of the loop or before the
+//    sample start is needed for interpolation
+//---------------------------------------------------------
 
-                  if (idx >= eidx) {
-                        off();
-                        break;
-                        }
+int Voice::blockFrames() const
+      {
+      long long n = BLOCK_SIZE;
+
+      if (_state == VoiceState::ATTACK) {
+            if (currentEnvelope == (trigger == Trigger::RELEASE ? V1Envelopes::RELEASE : V1Envelopes::SUSTAIN))
+                  return 0;
+            n = std::min(n, (long long)envelopes[currentEnvelope].count);
+            }
+      else if (_state == VoiceState::STOP) {
+            if (currentEnvelope != V1Envelopes::RELEASE)
+                  return 0;
+            n = std::min(n, (long long)envelopes[V1Envelopes::RELEASE].count);
+            }
+      else if (_state != VoiceState::PLAYING && _state != VoiceState::SUSTAINED)
+            return 0;
+      if (n <= 0 || eidx <= 0)
+            return 0;
 
-                  float interpVal = filter.interpolate(phase.fract(),
-                                                       getData(idx-1), getData(idx), getData(idx+1), getData(idx+2));
-                  float v = filter.apply(interpVal, true);
+      // same as in updateLoop()
+      const int loopOffset = (audioChan * 3) - 1;
+      const bool validLoop = _loopEnd > 0 && _loopStart >= 0 && (_loopEnd <= (eidx/audioChan));
+      const bool shallLoop = loopMode() == LoopMode::CONTINUOUS || (loopMode() == LoopMode::SUSTAIN && (_state < VoiceState::STOP));
+      const bool loop      = validLoop && shallLoop;
+      if (!loop && _looping)
+            return 0;
 
-                  updateEnvelopes();
-                  if (_state == VoiceState::OFF)
-                        break;
+      // range of sample frame indexes handled by processBlock()
+      const long long first = _looping ? _loopStart + 1 : 1;
+      long long last        = (eidx - 1) / audioChan;
+      if (loop)
+            last = std::min(last, _loopEnd - loopOffset);
 
-                  *p++  += v * envelopes[currentEnvelope].val * leftChannelVol;
-                  *p++  += v * envelopes[currentEnvelope].val * rightChannelVol;
+      const long long idx = phase.index();
+      if (idx < first || idx > last)
+            return 0;
+      if (V1Envelopes::DELAY != currentEnvelope && phaseIncr.data > 0) {
+            const long long k = (((last + 1) << 8) - phase.data + phaseIncr.data - 1) / phaseIncr.data;
+            n = std::min(n, k);
+            }
+      return int(n);
+      }
 
-                  if (V1Envelopes::DELAY != currentEnvelope)
-                        phase += phaseIncr;
+//---------------------------------------------------------
+//   processBlock
+//    render frames given by blockFrames(), same result
+//    as processFrame() for each of them
+//---------------------------------------------------------
+
+void Voice::processBlock(int frames, float* p, float leftChannelVol, float rightChannelVol)
+      {
+      float left[BLOCK_SIZE];
+      float right[BLOCK_SIZE];
+      Q_ASSERT(frames <= BLOCK_SIZE);
+
+      const int64_t incr = (V1Envelopes::DELAY != currentEnvelope) ? phaseIncr.data : 0;
 
-                  _samplesSinceStart++;
+      if (audioChan == 1) {
+            for (int i = 0; i < frames; ++i) {
+                  const short* d = data + phase.index();
+                  left[i] = filter.interpolate(phase.fract(), d[-1], d[0], d[1], d[2]);
+                  phase.data += incr;
                   }
+            filter.apply(left, frames);
             }
       else {
             //
             // handle interleaved stereo samples
             //
-            while (frames--) {
+            for (int i = 0; i < frames; ++i) {
+                  const short* d = data + phase.index() * 2;
+                  left[i]  = filter.interpolate(phase.fract(), d[-2], d[0], d[2], d[4]);
+                  right[i] = filter.interpolate(phase.fract(), d[-1], d[1], d[3], d[5]);
+                  phase.data += incr;
+                  }
+            filter.apply(left, right, frames);
+            }
 
-                  updateLoop();
+      //apply volume
+      const float* r = (audioChan == 1) ? left : right;
+      Envelope& e = envelopes[currentEnvelope];
+      if (_state == VoiceState::ATTACK || _state == VoiceState::STOP) {
+            for (int i = 0; i < frames; ++i) {
+                  e.step();
+                  *p++ += left[i] * e.val * leftChannelVol;
+                  *p++ += r[i]    * e.val * rightChannelVol;
+                  }
+            }
+      else {
+            for (int i = 0; i < frames; ++i) {
+                  *p++ += left[i] * e.val * leftChannelVol;
+                  *p++ += r[i]    * e.val * rightChannelVol;
+                  }
+            }
+      _samplesSinceStart += frames;
+      }
 
-                  long long idx = phase.index() * 2;
-                  if (idx >= eidx) {
-                        off();
-//printf("end of sample\n");
-                        break;
-                        }
-
-                  float interpValL = filter.interpolate(phase.fract(),
-                                                       getData(idx-2), getData(idx), getData(idx+2), getData(idx+4));
-                  float interpValR = filter.interpolate(phase.fract(),
-                                                       getData(idx-1), getData(idx+1), getData(idx+3), getData(idx+5));
-                  float valueL = filter.apply(interpValL, true);
-                  float valueR = filter.apply(interpValR, false);
-
-                  //apply volume
-                  updateEnvelopes();
-                  if (_state == VoiceState::OFF)
-                        break;
+//---------------------------------------------------------
+//   processFrame
+//    render one frame; return false if the voice is off
+//---------------------------------------------------------
+
+bool Voice::processFrame(float* p, float leftChannelVol, float rightChannelVol)
+      {
+      updateLoop();
+
+      if (audioChan == 1) {
+            long long idx = phase.index();
 
-                  *p++  += valueL * envelopes[currentEnvelope].val * leftChannelVol;
-                  *p++  += valueR * envelopes[currentEnvelope].val * rightChannelVol;
+            if (idx >= eidx) {
+                  off();
+                  return false;
+                  }
 
-                  if (V1Envelopes::DELAY != currentEnvelope)
-                        phase += phaseIncr;
+            float interpVal = filter.interpolate(phase.fract(),
+                                                 getData(idx-1), getData(idx), getData(idx+1), getData(idx+2));
+            float v = filter.apply(interpVal, true);
 
-                  _samplesSinceStart++;
+            updateEnvelopes();
+            if (_state == VoiceState::OFF)
+                  return false;
+
+            *p++  += v * envelopes[currentEnvelope].val * leftChannelVol;
+            *p++  += v * envelopes[currentEnvelope].val * rightChannelVol;
+            }
+      else {
+            //
+            // handle interleaved stereo samples
+            //
+            long long idx = phase.index() * 2;
+            if (idx >= eidx) {
+                  off();
+//printf("end of sample\n");
+                  return false;
                   }
+
+            float interpValL = filter.interpolate(phase.fract(),
+                                                 getData(idx-2), getData(idx), getData(idx+2), getData(idx+4));
+            float interpValR = filter.interpolate(phase.fract(),
+                                                 getData(idx-1), getData(idx+1), getData(idx+3), getData(idx+5));
+            float valueL = filter.apply(interpValL, true);
+            float valueR = filter.apply(interpValR, false);
+
+            //apply volume
+            updateEnvelopes();
+            if (_state == VoiceState::OFF)
+                  return false;
+
+            *p++  += valueL * envelopes[currentEnvelope].val * leftChannelVol;
+            *p++  += valueR * envelopes[currentEnvelope].val * rightChannelVol;
             }
+
+      if (V1Envelopes::DELAY != currentEnvelope)
+            phase += phaseIncr;
+
+      _samplesSinceStart++;
+      return true;
       }
 
 //---------------------------------------------------------
@@ -148,6 +148,10 @@ class Voice {
 
       const Zone* z;
 
+      int blockFrames() const;
+      void processBlock(int frames, float* p, float leftChannelVol, float rightChannelVol);
+      bool processFrame(float* p, float leftChannelVol, float rightChannelVol);
+
    public:
       Voice(Zerberus*);
       Voice* next() const         { return _next; }
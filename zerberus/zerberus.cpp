@@ -239,6 +239,19 @@ void Zerberus::process(unsigned frames, float* p, float*, float*)
             }
       }
 
+//---------------------------------------------------------
+//   voiceCount
+//    realtime
+//---------------------------------------------------------
+
+int Zerberus::voiceCount() const
+      {
+      int n = 0;
+      for (const Voice* v = activeVoices; v; v = v->next())
+            ++n;
+      return n;
+      }
+
 //---------------------------------------------------------
 //   name
 //---------------------------------------------------------
@@ -107,6 +107,7 @@ class Zerberus : public Ms::Synthesizer {
 
       ZInstrument* instrument(int program) const;
       Voice* getActiveVoices()      { return activeVoices; }
+      virtual int voiceCount() const override;
       Channel* channel(int n)       { return _channel[n]; }
       int loadProgress()            { return _loadProgress; }
       void setLoadProgress(int val) { _loadProgress = val; }